@@ -0,0 +1,255 @@
+/**
+ * @file benchmark_suite.cpp
+ * @brief Набор Google Benchmark для публичных операций S21BasicMatrix.
+ *
+ * Запуск: make bench. Каждая операция замеряется на ряде размеров; кроме
+ * времени выводятся счётчики flops (операции с плавающей точкой в
+ * секунду, по номинальной формуле для операции) и bytes_per_second
+ * (минимальный объём чтения и записи). Результаты пишутся в JSON-файл
+ * BENCH_JSON для архива и сравнения версий (tools/compare.py из
+ * Google Benchmark).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <random>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+/**
+ * @brief Квадратная матрица n x n с элементами из [-1, 1] и
+ * преобладающей диагональю, чтобы она была хорошо обусловлена.
+ */
+template <typename T>
+S21BasicMatrix<T> RandomMatrix(int n, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  S21BasicMatrix<T> matrix(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      matrix(i, j) = static_cast<T>(dist(gen));
+    }
+    matrix(i, i) += static_cast<T>(n);
+  }
+  return matrix;
+}
+
+/**
+ * @brief Задаёт счётчики пропускной способности на одну итерацию.
+ *
+ * @param flops Операций с плавающей точкой за итерацию.
+ * @param bytes Байт чтения и записи за итерацию.
+ */
+void SetThroughput(benchmark::State& state, double flops, double bytes) {
+  if (flops > 0.0) {
+    state.counters["flops"] =
+        benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate,
+                           benchmark::Counter::OneK::kIs1000);
+  }
+  state.SetBytesProcessed(static_cast<std::int64_t>(
+      static_cast<double>(state.iterations()) * bytes));
+}
+
+template <typename T>
+void BM_SumMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21BasicMatrix<T> a = RandomMatrix<T>(n, 1);
+  const S21BasicMatrix<T> b = RandomMatrix<T>(n, 2);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::DoNotOptimize(a.data());
+    benchmark::ClobberMemory();
+  }
+  const double elements = static_cast<double>(n) * n;
+  SetThroughput(state, elements, 3.0 * sizeof(T) * elements);
+}
+
+// MulMatrix - это *this = *this * other: замеряется то же произведение
+// без копирования левого множителя в каждой итерации
+template <typename T>
+void BM_MulMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21BasicMatrix<T> a = RandomMatrix<T>(n, 1);
+  const S21BasicMatrix<T> b = RandomMatrix<T>(n, 2);
+  for (auto _ : state) {
+    S21BasicMatrix<T> c = a * b;
+    benchmark::DoNotOptimize(c.data());
+  }
+  const double elements = static_cast<double>(n) * n;
+  SetThroughput(state, 2.0 * elements * n, 3.0 * sizeof(T) * elements);
+}
+
+// Штрассен-Виноград с порогом по умолчанию; flops - номинальные 2 n^3
+void BM_MulMatrixStrassen(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix<double>(n, 1);
+  const S21Matrix b = RandomMatrix<double>(n, 2);
+  S21Matrix c;
+  for (auto _ : state) {
+    c = a;
+    c.MulMatrix(b, S21MatrixMulAlgorithm::kStrassen);
+    benchmark::DoNotOptimize(c.data());
+  }
+  const double elements = static_cast<double>(n) * n;
+  SetThroughput(state, 2.0 * elements * n, 3.0 * sizeof(double) * elements);
+}
+
+// C += A * B на месте, без произведения во временной матрице
+template <typename T>
+void BM_Gemm(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21BasicMatrix<T> a = RandomMatrix<T>(n, 1);
+  const S21BasicMatrix<T> b = RandomMatrix<T>(n, 2);
+  S21BasicMatrix<T> c = RandomMatrix<T>(n, 3);
+  for (auto _ : state) {
+    S21BasicMatrix<T>::Gemm(T{1}, a, b, T{1}, c);
+    benchmark::DoNotOptimize(c.data());
+  }
+  const double elements = static_cast<double>(n) * n;
+  SetThroughput(state, 2.0 * elements * n, 4.0 * sizeof(T) * elements);
+}
+
+// y = A * x для столбцов x и y
+template <typename T>
+void BM_Gemv(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21BasicMatrix<T> a = RandomMatrix<T>(n, 1);
+  S21BasicMatrix<T> x(n, 1);
+  S21BasicMatrix<T> y(n, 1);
+  for (int i = 0; i < n; ++i) {
+    x(i, 0) = T{1};
+  }
+  for (auto _ : state) {
+    S21BasicMatrix<T>::Gemv(T{1}, a, x, T{0}, y);
+    benchmark::DoNotOptimize(y.data());
+  }
+  const double elements = static_cast<double>(n) * n;
+  SetThroughput(state, 2.0 * elements, sizeof(T) * (elements + 2.0 * n));
+}
+
+template <typename T>
+void BM_Transpose(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21BasicMatrix<T> a = RandomMatrix<T>(n, 1);
+  for (auto _ : state) {
+    S21BasicMatrix<T> t = a.Transpose();
+    benchmark::DoNotOptimize(t.data());
+  }
+  SetThroughput(state, 0.0, 2.0 * sizeof(T) * n * n);
+}
+
+void BM_Determinant(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix<double>(n, 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Determinant());
+  }
+  // LU-разложение: 2/3 n^3
+  SetThroughput(state, 2.0 / 3.0 * n * n * n, sizeof(double) * n * n);
+}
+
+void BM_InverseMatrix(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix inverse = a.InverseMatrix();
+    benchmark::DoNotOptimize(inverse.data());
+  }
+  // LU-разложение и обращение множителей: 2 n^3
+  SetThroughput(state, 2.0 * n * n * n, 2.0 * sizeof(double) * n * n);
+}
+
+void BM_CalcComplements(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix complements = a.CalcComplements();
+    benchmark::DoNotOptimize(complements.data());
+  }
+  // через определитель и обратную матрицу: 2 n^3
+  SetThroughput(state, 2.0 * n * n * n, 2.0 * sizeof(double) * n * n);
+}
+
+void BM_CopyConstructor(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix copy(a);
+    benchmark::DoNotOptimize(copy.data());
+  }
+  SetThroughput(state, 0.0, 2.0 * sizeof(double) * n * n);
+}
+
+// два переноса за итерацию, чтобы матрица вернулась на место
+void BM_MoveConstructor(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  S21Matrix a = RandomMatrix<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(a));
+    benchmark::DoNotOptimize(moved.data());
+    a = std::move(moved);
+  }
+  state.SetItemsProcessed(2 * state.iterations());
+}
+
+void BM_OutputOperator(benchmark::State& state) {
+  const int n = static_cast<int>(state.range(0));
+  const S21Matrix a = RandomMatrix<double>(n, 1);
+  std::ostringstream os;
+  double bytes = 0.0;
+  for (auto _ : state) {
+    os.str(std::string());
+    os << a;
+    bytes = static_cast<double>(os.tellp());
+    benchmark::DoNotOptimize(bytes);
+  }
+  // байты текста на выходе
+  SetThroughput(state, 0.0, bytes);
+}
+
+BENCHMARK_TEMPLATE(BM_SumMatrix, double)->RangeMultiplier(4)->Range(8, 2048);
+BENCHMARK_TEMPLATE(BM_SumMatrix, float)->RangeMultiplier(4)->Range(8, 2048);
+BENCHMARK_TEMPLATE(BM_MulMatrix, double)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_MulMatrix, float)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK(BM_MulMatrixStrassen)
+    ->RangeMultiplier(2)
+    ->Range(1024, 4096)
+    ->Unit(benchmark::kMillisecond);
+BENCHMARK_TEMPLATE(BM_Gemm, double)->RangeMultiplier(2)->Range(8, 1024);
+BENCHMARK_TEMPLATE(BM_Gemv, double)->RangeMultiplier(4)->Range(8, 2048);
+BENCHMARK_TEMPLATE(BM_Transpose, double)->RangeMultiplier(4)->Range(8, 2048);
+BENCHMARK(BM_Determinant)->RangeMultiplier(2)->Range(8, 512);
+BENCHMARK(BM_InverseMatrix)->RangeMultiplier(2)->Range(8, 512);
+BENCHMARK(BM_CalcComplements)->RangeMultiplier(2)->Range(8, 512);
+// 2 и 4 - во встроенном буфере, остальные в куче
+BENCHMARK(BM_CopyConstructor)->RangeMultiplier(4)->Range(2, 2048);
+BENCHMARK(BM_MoveConstructor)->RangeMultiplier(4)->Range(2, 2048);
+BENCHMARK(BM_OutputOperator)->RangeMultiplier(4)->Range(8, 512);
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  // попадают в "context" отчёта JSON вместе с описанием машины
+  benchmark::AddCustomContext("simd_isa",
+                              s21::simd::IsaName(s21::simd::ActiveIsa()));
+  benchmark::AddCustomContext(
+      "thread_pool_threads",
+      std::to_string(S21ThreadPool::Instance().GetNumThreads()));
+  benchmark::AddCustomContext("inline_capacity",
+                              std::to_string(S21_MATRIX_INLINE_CAPACITY));
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv)) {
+    return 1;
+  }
+  benchmark::RunSpecifiedBenchmarks();
+  benchmark::Shutdown();
+  return 0;
+}
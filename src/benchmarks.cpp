@@ -0,0 +1,600 @@
+/**
+ * @file benchmarks.cpp
+ * @brief Замеры производительности операций класса S21Matrix.
+ *
+ * Запуск: make bench_compare. Каждый замер повторяется, пока суммарное
+ * время не превысит kMinSeconds, в таблицу выводится лучшее время одного
+ * прогона.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <functional>
+#include <random>
+#include <string>
+#include <utility>
+#include <thread>
+#include <vector>
+
+#include "s21_fixed_matrix.h"
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_simd.h"
+#include "s21_sparse_matrix.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+constexpr double kMinSeconds = 0.3;
+
+/**
+ * @brief Возвращает лучшее время (в секундах) одного вызова body.
+ */
+double Measure(const std::function<void()>& body) {
+  using Clock = std::chrono::steady_clock;
+  double best = 1e30;
+  double total = 0.0;
+  do {
+    const auto start = Clock::now();
+    body();
+    const double elapsed =
+        std::chrono::duration<double>(Clock::now() - start).count();
+    best = std::min(best, elapsed);
+    total += elapsed;
+  } while (total < kMinSeconds);
+  return best;
+}
+
+/**
+ * @brief Заполняет матрицу псевдослучайными числами из [-1, 1].
+ */
+S21Matrix RandomMatrix(int rows, int cols, unsigned seed) {
+  std::mt19937 gen(seed);
+  std::uniform_real_distribution<double> dist(-1.0, 1.0);
+  S21Matrix matrix(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      matrix(i, j) = dist(gen);
+    }
+  }
+  return matrix;
+}
+
+/**
+ * @brief Прежнее ядро MulMatrix (цикл i-j-k) для сравнения.
+ */
+S21Matrix NaiveMul(const S21Matrix& a, const S21Matrix& b) {
+  S21Matrix result(a.GetRows(), b.GetCols());
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < b.GetCols(); ++j) {
+      for (int k = 0; k < b.GetRows(); ++k) {
+        result(i, j) += a(i, k) * b(k, j);
+      }
+    }
+  }
+  return result;
+}
+
+void BenchMulMatrix() {
+  std::printf("MulMatrix, GFLOP/s\n");
+  std::printf("%6s %12s %12s %9s\n", "n", "naive", "blocked", "speedup");
+  for (int n : {64, 128, 256, 512, 1024}) {
+    const S21Matrix a = RandomMatrix(n, n, 1);
+    const S21Matrix b = RandomMatrix(n, n, 2);
+    const double flops = 2.0 * n * n * n;
+
+    const double naive = Measure([&] { NaiveMul(a, b); });
+    const double blocked = Measure([&] {
+      S21Matrix c = a;
+      c.MulMatrix(b);
+    });
+    std::printf("%6d %12.2f %12.2f %8.1fx\n", n, flops / naive * 1e-9,
+                flops / blocked * 1e-9, naive / blocked);
+  }
+}
+
+void BenchMulMatrixScaling() {
+  const int n = 1024;
+  const S21Matrix a = RandomMatrix(n, n, 3);
+  const S21Matrix b = RandomMatrix(n, n, 4);
+  const double flops = 2.0 * n * n * n;
+
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  const int initial_threads = pool.GetNumThreads();
+  const int max_threads =
+      std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+
+  std::printf("\nMulMatrix %dx%d, scaling over threads\n", n, n);
+  std::printf("%8s %12s %9s %11s\n", "threads", "GFLOP/s", "speedup",
+              "efficiency");
+  // 1, 2, 4, ... и само число ядер
+  std::vector<int> counts;
+  for (int threads = 1; threads < max_threads; threads *= 2) {
+    counts.push_back(threads);
+  }
+  counts.push_back(max_threads);
+
+  double base = 0.0;
+  for (int threads : counts) {
+    pool.SetNumThreads(threads);
+    const double seconds = Measure([&] {
+      S21Matrix c = a;
+      c.MulMatrix(b);
+    });
+    if (threads == 1) {
+      base = seconds;
+    }
+    std::printf("%8d %12.2f %8.1fx %10.0f%%\n", threads,
+                flops / seconds * 1e-9, base / seconds,
+                100.0 * base / seconds / threads);
+  }
+  pool.SetNumThreads(initial_threads);
+}
+
+/**
+ * @brief Прежний Transpose: запись в столбец с шагом в целую строку.
+ */
+void NaiveTranspose(const S21Matrix& matrix, S21Matrix& transposed) {
+  for (int i = 0; i < matrix.GetRows(); ++i) {
+    for (int j = 0; j < matrix.GetCols(); ++j) {
+      transposed(j, i) = matrix(i, j);
+    }
+  }
+}
+
+void BenchTranspose() {
+  std::printf("\nTranspose, GB/s (чтение + запись)\n");
+  std::printf("%6s %12s %12s %12s\n", "n", "naive", "blocked", "in-place");
+  for (int n : {64, 256, 1024, 2048, 4096, 8192}) {
+    S21Matrix a = RandomMatrix(n, n, 8);
+    S21Matrix t(n, n);
+    const double bytes = 2.0 * sizeof(double) * n * n;
+
+    const double naive = Measure([&] { NaiveTranspose(a, t); });
+    // в готовый буфер, как и naive: без выделения новой матрицы
+    const double blocked = Measure([&] {
+      s21::kernels::Transpose(a.data(), a.GetStride(), t.data(),
+                              t.GetStride(), n, n);
+    });
+    const double in_place = Measure([&] { a.TransposeInPlace(); });
+    std::printf("%6d %12.2f %12.2f %12.2f\n", n, bytes / naive * 1e-9,
+                bytes / blocked * 1e-9, bytes / in_place * 1e-9);
+  }
+}
+
+void BenchTransposedMul() {
+  std::printf("\nA^T * B, GFLOP/s\n");
+  std::printf("%6s %12s %12s %9s\n", "n", "copy", "view", "speedup");
+  for (int n : {256, 1024}) {
+    const S21Matrix a = RandomMatrix(n, n, 9);
+    const S21Matrix b = RandomMatrix(n, n, 10);
+    const double flops = 2.0 * n * n * n;
+
+    const double copy = Measure([&] { S21Matrix c = a.Transpose() * b; });
+    const double view = Measure([&] { S21Matrix c = a.TransposeView() * b; });
+    std::printf("%6d %12.2f %12.2f %8.1fx\n", n, flops / copy * 1e-9,
+                flops / view * 1e-9, copy / view);
+  }
+}
+
+void BenchAllocators() {
+  std::printf("\nВременные матрицы r = (a * b + a) * 2, нс на выражение\n");
+  std::printf("%6s %10s %10s %10s %10s\n", "n", "global", "pool", "arena",
+              "pool hits");
+  const int iterations = 1000;
+  for (int n : {4, 16, 64}) {
+    const S21Matrix a = RandomMatrix(n, n, 11);
+    const S21Matrix b = RandomMatrix(n, n, 12);
+    auto body = [&] {
+      for (int i = 0; i < iterations; ++i) {
+        S21Matrix r = (a * b + a) * 2.0;
+      }
+    };
+
+    const double global = Measure(body);
+    S21MatrixAllocator::ResetStats();
+    double pool = 0.0;
+    {
+      S21MatrixAllocatorScope scope(S21MatrixAllocator::Pool());
+      pool = Measure(body);
+    }
+    const double hit_rate = S21MatrixAllocator::GetStats().HitRate();
+    double arena = 0.0;
+    {
+      S21MatrixArena scope;
+      arena = Measure(body);
+    }
+    std::printf("%6d %10.0f %10.0f %10.0f %9.1f%%\n", n,
+                global / iterations * 1e9, pool / iterations * 1e9,
+                arena / iterations * 1e9, 100.0 * hit_rate);
+  }
+}
+
+void BenchElementwiseChain() {
+  std::printf("\nr = a + b - c * 2, GB/s\n");
+  std::printf("%6s %12s %12s %9s\n", "n", "eager", "fused", "speedup");
+  for (int n : {256, 1024, 2048}) {
+    const S21Matrix a = RandomMatrix(n, n, 5);
+    const S21Matrix b = RandomMatrix(n, n, 6);
+    const S21Matrix c = RandomMatrix(n, n, 7);
+    // три чтения и одна запись на элемент
+    const double bytes = 4.0 * sizeof(double) * n * n;
+
+    S21Matrix r(n, n);
+    const double eager = Measure([&] {
+      S21Matrix sum = a;
+      sum.SumMatrix(b);
+      S21Matrix twice = c;
+      twice.MulNumber(2);
+      sum.SubMatrix(twice);
+      r = sum;
+    });
+    const double fused = Measure([&] { r = a + b - c * 2; });
+    std::printf("%6d %12.2f %12.2f %8.1fx\n", n, bytes / eager * 1e-9,
+                bytes / fused * 1e-9, eager / fused);
+  }
+}
+
+void BenchSmallBuffer() {
+  std::printf("\nСоздание, копия, перенос и a + b * 2, встроенный буфер до %d "
+              "элементов\n",
+              S21_MATRIX_INLINE_CAPACITY);
+  std::printf("%6s %10s %10s\n", "n", "ns", "allocs");
+  const int iterations = 1000;
+  for (int n : {2, 3, 4, 5, 8}) {
+    const S21Matrix a = RandomMatrix(n, n, 15);
+    const S21Matrix b = RandomMatrix(n, n, 16);
+    auto body = [&] {
+      for (int i = 0; i < iterations; ++i) {
+        S21Matrix fresh(n, n);
+        S21Matrix copy(a);
+        fresh = std::move(copy);
+        S21Matrix r = fresh + b * 2;
+        asm volatile("" : : "g"(r.data()) : "memory");
+      }
+    };
+
+    S21MatrixAllocator::ResetStats();
+    body();
+    const double allocations =
+        static_cast<double>(S21MatrixAllocator::GetStats().allocations) /
+        iterations;
+    const double seconds = Measure(body);
+    std::printf("%6d %10.0f %10.1f\n", n, seconds / iterations * 1e9,
+                allocations);
+  }
+}
+
+void BenchFixedMatrix() {
+  std::printf("\nМалые матрицы n x n: a * b + a, нс на выражение\n");
+  std::printf("%6s %10s %10s %9s\n", "n", "dynamic", "fixed", "speedup");
+  const int iterations = 1000;
+  const S21Matrix a4 = RandomMatrix(4, 4, 13);
+  const S21Matrix b4 = RandomMatrix(4, 4, 14);
+  auto row = [&](int n, const S21Matrix& a, const S21Matrix& b, auto fa,
+                 auto fb) {
+    const double dynamic = Measure([&] {
+      for (int i = 0; i < iterations; ++i) {
+        S21Matrix r = a * b + a;
+      }
+    });
+    decltype(fa) r;
+    const double fixed = Measure([&] {
+      for (int i = 0; i < iterations; ++i) {
+        r = fa * fb + fa;
+        // не даём компилятору вынести вычисление из цикла
+        asm volatile("" : : "g"(&r) : "memory");
+      }
+    });
+    std::printf("%6d %10.0f %10.0f %8.1fx\n", n, dynamic / iterations * 1e9,
+                fixed / iterations * 1e9, dynamic / fixed);
+  };
+  for (int n : {2, 3, 4}) {
+    const S21Matrix a = a4.Block(0, 0, n, n);
+    const S21Matrix b = b4.Block(0, 0, n, n);
+    if (n == 2) {
+      row(n, a, b, S21Matrix2(a), S21Matrix2(b));
+    } else if (n == 3) {
+      row(n, a, b, S21Matrix3(a), S21Matrix3(b));
+    } else {
+      row(n, a, b, S21Matrix4(a), S21Matrix4(b));
+    }
+  }
+}
+
+void BenchSparse() {
+  const int n = 2048;
+  const int k = 64;
+  std::printf("\nA (%dx%d) * B (%dx%d), мс; память A, МБ\n", n, n, n, k);
+  std::printf("%8s %10s %10s %10s %10s %10s\n", "density", "dense", "csr",
+              "csc", "dense MB", "csr MB");
+  const S21Matrix b = RandomMatrix(n, k, 17);
+  for (double density : {0.001, 0.01, 0.05, 0.2}) {
+    std::mt19937 gen(18);
+    std::uniform_real_distribution<double> dist(0.0, 1.0);
+    S21Matrix a(n, n);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        if (dist(gen) < density) {
+          a(i, j) = dist(gen);
+        }
+      }
+    }
+    const S21SparseMatrix csr(a);
+    const S21SparseMatrix csc(a, S21SparseFormat::kCsc);
+
+    const double dense = Measure([&] { S21Matrix c = a * b; });
+    const double sparse_csr = Measure([&] { S21Matrix c = csr * b; });
+    const double sparse_csc = Measure([&] { S21Matrix c = csc * b; });
+    const double dense_mb = sizeof(double) * n * a.GetStride() / 1e6;
+    const double csr_mb =
+        ((sizeof(double) + sizeof(int)) * csr.GetNonZeros() +
+         sizeof(int) * (n + 1)) / 1e6;
+    std::printf("%7.1f%% %10.2f %10.2f %10.2f %10.1f %10.2f\n",
+                100.0 * density, dense * 1e3, sparse_csr * 1e3,
+                sparse_csc * 1e3, dense_mb, csr_mb);
+  }
+}
+
+void BenchLoad() {
+  const int n = 4096;
+  const std::string path =
+      (std::filesystem::temp_directory_path() / "s21_matrix_bench.bin")
+          .string();
+  const S21Matrix a = RandomMatrix(n, n, 19);
+  const double megabytes = sizeof(double) * n * a.GetStride() / 1e6;
+  const double save = Measure([&] { a.Save(path); });
+
+  std::printf("\nSave / Load %dx%d (%.0f МБ), мс\n", n, n, megabytes);
+  std::printf("%22s %10s %12s\n", "", "load", "load + sum");
+  std::printf("%22s %10.2f\n", "save", save * 1e3);
+  const std::pair<const char*, S21MatrixLoadMode> modes[] = {
+      {"copy", S21MatrixLoadMode::kCopy},
+      {"mmap copy-on-write", S21MatrixLoadMode::kCopyOnWrite}};
+  for (const auto& [name, mode] : modes) {
+    const double load =
+        Measure([&] { S21Matrix m = S21Matrix::Load(path, mode); });
+    // с чтением всех элементов: для отображения - подгрузка страниц
+    const double touch = Measure([&] {
+      const S21Matrix m = S21Matrix::Load(path, mode);
+      double sum = 0.0;
+      for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+          sum += m(i, j);
+        }
+      }
+      asm volatile("" : : "g"(sum));
+    });
+    std::printf("%22s %10.3f %12.2f\n", name, load * 1e3, touch * 1e3);
+  }
+  const double view_load = Measure([&] { S21Matrix::LoadView(path); });
+  const double view_touch = Measure([&] {
+    const S21MatrixView view = S21Matrix::LoadView(path);
+    double sum = 0.0;
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        sum += view(i, j);
+      }
+    }
+    asm volatile("" : : "g"(sum));
+  });
+  std::printf("%22s %10.3f %12.2f\n", "LoadView (read-only)", view_load * 1e3,
+              view_touch * 1e3);
+  const double verify = Measure([&] {
+    S21Matrix m = S21Matrix::Load(path, S21MatrixLoadMode::kCopyOnWrite, true);
+  });
+  std::printf("%22s %10.2f\n", "mmap + verify", verify * 1e3);
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief Умножение файлов по тайлам при разных бюджетах памяти против
+ * умножения в памяти.
+ */
+void BenchMulFiles() {
+  const int n = 2048;
+  const auto temp = std::filesystem::temp_directory_path();
+  const std::string a_path = (temp / "s21_matrix_bench_a.bin").string();
+  const std::string b_path = (temp / "s21_matrix_bench_b.bin").string();
+  const std::string c_path = (temp / "s21_matrix_bench_c.bin").string();
+  const S21Matrix a = RandomMatrix(n, n, 23);
+  const S21Matrix b = RandomMatrix(n, n, 29);
+  a.Save(a_path);
+  b.Save(b_path);
+  const double flops = 2.0 * n * n * n;
+
+  std::printf("\nMulFiles %dx%d, с (GFLOP/s)\n", n, n);
+  const double in_memory = Measure([&] {
+    const S21Matrix a_loaded = S21Matrix::Load(a_path);
+    S21Matrix c = S21Matrix::Load(b_path);
+    c = a_loaded * c;
+    c.Save(c_path);
+  });
+  std::printf("%22s %8.3f (%.1f)\n", "load + mul + save", in_memory,
+              flops / in_memory / 1e9);
+  for (std::size_t megabytes : {256, 64, 16}) {
+    const double time = Measure([&] {
+      S21Matrix::MulFiles(a_path, b_path, c_path, megabytes << 20);
+    });
+    std::printf("%19zu MB %8.3f (%.1f)\n", megabytes, time,
+                flops / time / 1e9);
+  }
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+/**
+ * @brief Решение A * X = B через Solve против InverseMatrix() * B.
+ */
+void BenchSolve() {
+  std::printf("\nSolve n x n, nrhs правых частей, с\n");
+  std::printf("%6s %6s %12s %12s %12s\n", "n", "nrhs", "inverse*B", "lu",
+              "cholesky");
+  for (int n : {256, 1024}) {
+    const S21Matrix a = RandomMatrix(n, n, 47);
+    // A^T * A + n * E: симметричная положительно определённая
+    S21Matrix spd = a.Transpose() * a;
+    for (int i = 0; i < n; ++i) {
+      spd(i, i) += n;
+    }
+    for (int nrhs : {1, 64}) {
+      const S21Matrix b = RandomMatrix(n, nrhs, 53);
+      S21Matrix x;
+      const double inverse = Measure([&] { x = spd.InverseMatrix() * b; });
+      const double lu =
+          Measure([&] { x = spd.Solve(b, S21MatrixSolver::kLU); });
+      const double cholesky =
+          Measure([&] { x = spd.Solve(b, S21MatrixSolver::kCholesky); });
+      std::printf("%6d %6d %12.4f %12.4f %12.4f\n", n, nrhs, inverse, lu,
+                  cholesky);
+    }
+  }
+}
+
+/**
+ * @brief Накопление произведения: c += a * b против Gemm с beta = 1 и
+ * a * x против Gemv.
+ */
+void BenchGemm() {
+  std::printf("\nC += A * B, n x n, с\n");
+  std::printf("%6s %12s %12s\n", "n", "c += a * b", "Gemm");
+  for (int n : {64, 256, 1024}) {
+    const S21Matrix a = RandomMatrix(n, n, 59);
+    const S21Matrix b = RandomMatrix(n, n, 61);
+    S21Matrix c = RandomMatrix(n, n, 67);
+    const double operators = Measure([&] { c += a * b; });
+    const double gemm =
+        Measure([&] { S21Matrix::Gemm(1.0, a, b, 1.0, c); });
+    std::printf("%6d %12.5f %12.5f\n", n, operators, gemm);
+  }
+
+  std::printf("\ny = A * x и y = A^T * x, n x n, с\n");
+  std::printf("%6s %12s %12s %12s %12s\n", "n", "a * x", "Gemv",
+              "a^T * x", "Gemv^T");
+  for (int n : {256, 2048}) {
+    const S21Matrix a = RandomMatrix(n, n, 71);
+    const S21Matrix x = RandomMatrix(n, 1, 73);
+    S21Matrix y(n, 1);
+    const double operators = Measure([&] { y = a * x; });
+    const double gemv = Measure([&] { S21Matrix::Gemv(1.0, a, x, 0.0, y); });
+    const double transposed_operators =
+        Measure([&] { y = a.TransposeView() * x; });
+    const double transposed_gemv = Measure([&] {
+      S21Matrix::Gemv(1.0, a, x, 0.0, y, S21MatrixTranspose::kTranspose);
+    });
+    std::printf("%6d %12.5f %12.5f %12.5f %12.5f\n", n, operators, gemv,
+                transposed_operators, transposed_gemv);
+  }
+}
+
+/**
+ * @brief Штрассен-Виноград против блочного GEMM на больших квадратных
+ * матрицах.
+ */
+void BenchStrassen() {
+  std::printf("\nMulMatrix n x n, с (GFLOP/s), порог Штрассена %d\n",
+              S21Matrix::GetStrassenCrossover());
+  std::printf("%6s %18s %18s\n", "n", "blocked", "strassen");
+  for (int n : {1024, 2048, 4096}) {
+    const S21Matrix a = RandomMatrix(n, n, 41);
+    const S21Matrix b = RandomMatrix(n, n, 43);
+    const double flops = 2.0 * n * n * n;
+    double times[2];
+    int column = 0;
+    for (S21MatrixMulAlgorithm algorithm :
+         {S21MatrixMulAlgorithm::kBlocked, S21MatrixMulAlgorithm::kStrassen}) {
+      S21Matrix c;
+      times[column++] = Measure([&] {
+        c = a;
+        c.MulMatrix(b, algorithm);
+      });
+    }
+    std::printf("%6d %8.3f (%6.1f) %8.3f (%6.1f)\n", n, times[0],
+                flops / times[0] / 1e9, times[1], flops / times[1] / 1e9);
+  }
+}
+
+/**
+ * @brief Пакет малых матриц против цикла по отдельным S21Matrix.
+ */
+void BenchBatch() {
+  const int count = 100000;
+  std::printf("\nПакет из %d матриц n x n, нс на матрицу\n", count);
+  std::printf("%6s %10s %10s %10s %10s %10s %10s\n", "n", "mul", "batch",
+              "inverse", "batch", "det", "batch");
+  for (int n : {2, 4, 8}) {
+    std::vector<S21Matrix> a;
+    std::vector<S21Matrix> b;
+    for (int k = 0; k < count; ++k) {
+      a.push_back(RandomMatrix(n, n, 31 + k));
+      b.push_back(RandomMatrix(n, n, 37 + k));
+      for (int i = 0; i < n; ++i) {
+        a.back()(i, i) += n;
+      }
+    }
+    const S21MatrixBatch batch_a(a);
+    const S21MatrixBatch batch_b(b);
+    const double mul = Measure([&] {
+      for (int k = 0; k < count; ++k) {
+        S21Matrix c = a[k] * b[k];
+        asm volatile("" : : "g"(c.data()) : "memory");
+      }
+    });
+    // копия в уже выделенный буфер: MulMatrix квадратных пакетов не
+    // выделяет память, как и цикл, берущий буферы из пула
+    S21MatrixBatch product = batch_a;
+    const double batch_mul = Measure([&] {
+      product = batch_a;
+      product.MulMatrix(batch_b);
+    });
+    const double inverse = Measure([&] {
+      for (int k = 0; k < count; ++k) {
+        S21Matrix c = a[k].InverseMatrix();
+        asm volatile("" : : "g"(c.data()) : "memory");
+      }
+    });
+    const double batch_inverse =
+        Measure([&] { S21MatrixBatch c = batch_a.InverseMatrix(); });
+    double sink = 0.0;
+    const double det = Measure([&] {
+      for (int k = 0; k < count; ++k) {
+        sink += a[k].Determinant();
+      }
+    });
+    const double batch_det =
+        Measure([&] { sink += batch_a.Determinant()[0]; });
+    asm volatile("" : : "g"(&sink) : "memory");
+    const double scale = 1e9 / count;
+    std::printf("%6d %10.1f %10.1f %10.1f %10.1f %10.1f %10.1f\n", n,
+                mul * scale, batch_mul * scale, inverse * scale,
+                batch_inverse * scale, det * scale, batch_det * scale);
+  }
+}
+
+}  // namespace
+
+int main() {
+  std::printf("SIMD ISA: %s\n\n",
+              s21::simd::IsaName(s21::simd::ActiveIsa()));
+  BenchMulMatrix();
+  BenchMulMatrixScaling();
+  BenchTransposedMul();
+  BenchAllocators();
+  BenchElementwiseChain();
+  BenchTranspose();
+  BenchSmallBuffer();
+  BenchFixedMatrix();
+  BenchSparse();
+  BenchLoad();
+  BenchMulFiles();
+  BenchSolve();
+  BenchGemm();
+  BenchStrassen();
+  BenchBatch();
+  return 0;
+}
@@ -0,0 +1,280 @@
+/**
+ * @file matrix_allocator.cpp
+ * @brief Реализация распределителей буферов S21Matrix.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <new>
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+
+namespace {
+
+constexpr std::size_t kAlignment = 64;
+
+// Классы пула: степени двойки от 64 байт до 4 МБ
+constexpr int kMinClassShift = 6;
+constexpr int kMaxClassShift = 22;
+constexpr int kClassCount = kMaxClassShift - kMinClassShift + 1;
+// Сколько свободных блоков одного класса хранит поток
+constexpr std::size_t kMaxCachedBlocks = 8;
+
+std::atomic<unsigned long long> allocations{0};
+std::atomic<unsigned long long> pool_hits{0};
+std::atomic<unsigned long long> pool_misses{0};
+std::atomic<unsigned long long> arena_allocations{0};
+std::atomic<unsigned long long> system_allocations{0};
+
+void Count(std::atomic<unsigned long long>& counter) {
+  counter.fetch_add(1, std::memory_order_relaxed);
+}
+
+void* SystemAllocate(std::size_t bytes) {
+  Count(system_allocations);
+  return ::operator new(bytes, std::align_val_t(kAlignment));
+}
+
+void SystemDeallocate(void* ptr) noexcept {
+  ::operator delete(ptr, std::align_val_t(kAlignment));
+}
+
+std::size_t RoundUp(std::size_t bytes) {
+  return (bytes + kAlignment - 1) / kAlignment * kAlignment;
+}
+
+// --> Global
+
+class GlobalAllocator final : public S21MatrixAllocator {
+ public:
+  void* Allocate(std::size_t bytes) override {
+    Count(allocations);
+    return SystemAllocate(bytes);
+  }
+  void Deallocate(void* ptr, std::size_t) noexcept override {
+    SystemDeallocate(ptr);
+  }
+};
+
+// --> Pool
+
+/**
+ * @brief Возвращает класс размера или -1, если блок слишком велик для пула.
+ */
+int SizeClass(std::size_t bytes) {
+  int shift = kMinClassShift;
+  while ((std::size_t{1} << shift) < bytes) {
+    ++shift;
+  }
+  return shift <= kMaxClassShift ? shift - kMinClassShift : -1;
+}
+
+// Признак разрушенного кэша: тривиальная thread_local-переменная остаётся
+// доступной, когда буфер освобождается при завершении потока
+thread_local bool tls_pool_destroyed = false;
+
+struct PoolCache {
+  std::vector<void*> blocks[kClassCount];
+
+  ~PoolCache() {
+    for (std::vector<void*>& list : blocks) {
+      for (void* ptr : list) {
+        SystemDeallocate(ptr);
+      }
+    }
+    tls_pool_destroyed = true;
+  }
+};
+
+thread_local PoolCache tls_pool;
+
+/**
+ * @brief Фасад потоковых кэшей: блок, освобождённый в другом потоке,
+ * попадает в кэш этого потока.
+ */
+class PoolAllocator final : public S21MatrixAllocator {
+ public:
+  void* Allocate(std::size_t bytes) override {
+    Count(allocations);
+    const int size_class = SizeClass(bytes);
+    if (size_class < 0 || tls_pool_destroyed) {
+      Count(pool_misses);
+      return SystemAllocate(bytes);
+    }
+    std::vector<void*>& list = tls_pool.blocks[size_class];
+    if (!list.empty()) {
+      Count(pool_hits);
+      void* ptr = list.back();
+      list.pop_back();
+      return ptr;
+    }
+    Count(pool_misses);
+    return SystemAllocate(std::size_t{1} << (size_class + kMinClassShift));
+  }
+
+  void Deallocate(void* ptr, std::size_t bytes) noexcept override {
+    const int size_class = SizeClass(bytes);
+    if (size_class < 0 || tls_pool_destroyed) {
+      SystemDeallocate(ptr);
+      return;
+    }
+    std::vector<void*>& list = tls_pool.blocks[size_class];
+    if (list.size() >= kMaxCachedBlocks) {
+      SystemDeallocate(ptr);
+      return;
+    }
+    try {
+      list.push_back(ptr);
+    } catch (...) {
+      SystemDeallocate(ptr);
+    }
+  }
+};
+
+// --> Arena
+
+/**
+ * @brief Состояние арены. Живёт, пока жив объект S21MatrixArena или хотя бы
+ * один выделенный ею блок (счётчик ссылок refs_).
+ */
+class ArenaResource final : public S21MatrixAllocator {
+ public:
+  explicit ArenaResource(std::size_t chunk_bytes)
+      : chunk_bytes_(RoundUp(std::max(chunk_bytes, kAlignment))) {}
+
+  ~ArenaResource() override {
+    for (const Chunk& chunk : chunks_) {
+      SystemDeallocate(chunk.data);
+    }
+  }
+
+  // Вызывается только потоком, создавшим арену
+  void* Allocate(std::size_t bytes) override {
+    Count(allocations);
+    bytes = RoundUp(bytes);
+    if (refs_.load(std::memory_order_acquire) == 1) {
+      // все блоки освобождены: куски используются заново
+      current_ = 0;
+      offset_ = 0;
+    }
+    while (current_ < chunks_.size() &&
+           offset_ + bytes > chunks_[current_].size) {
+      ++current_;
+      offset_ = 0;
+    }
+    if (current_ == chunks_.size()) {
+      const std::size_t size = std::max(chunk_bytes_, bytes);
+      chunks_.push_back({static_cast<char*>(SystemAllocate(size)), size});
+      offset_ = 0;
+    }
+    Count(arena_allocations);
+    void* ptr = chunks_[current_].data + offset_;
+    offset_ += bytes;
+    refs_.fetch_add(1, std::memory_order_relaxed);
+    return ptr;
+  }
+
+  void Deallocate(void*, std::size_t) noexcept override { Release(); }
+
+  void Release() noexcept {
+    if (refs_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+      delete this;
+    }
+  }
+
+ private:
+  struct Chunk {
+    char* data;
+    std::size_t size;
+  };
+
+  std::size_t chunk_bytes_;
+  std::vector<Chunk> chunks_;
+  std::size_t current_ = 0;
+  std::size_t offset_ = 0;
+  std::atomic<long> refs_{1};  // объект арены + живые блоки
+};
+
+// Не разрушаются при завершении программы: буферы статических матриц
+// могут освобождаться позже
+GlobalAllocator& GlobalInstance() {
+  static GlobalAllocator* const instance = new GlobalAllocator;
+  return *instance;
+}
+
+PoolAllocator& PoolInstance() {
+  static PoolAllocator* const instance = new PoolAllocator;
+  return *instance;
+}
+
+thread_local S21MatrixAllocator* tls_current = &GlobalInstance();
+
+}  // namespace
+
+/**
+ * @brief Доля запросов к пулу, обслуженных из его кэша.
+ *
+ * Запросы к другим распределителям не учитываются, поэтому значение не
+ * падает, когда часть матриц создаётся через Global().
+ *
+ * @return Значение из [0, 1]; 0, если к пулу не обращались.
+ */
+double S21MatrixAllocatorStats::HitRate() const {
+  const unsigned long long requests = pool_hits + pool_misses;
+  if (requests == 0) {
+    return 0.0;
+  }
+  return static_cast<double>(pool_hits) / static_cast<double>(requests);
+}
+
+S21MatrixAllocator& S21MatrixAllocator::Current() { return *tls_current; }
+
+S21MatrixAllocator& S21MatrixAllocator::Global() { return GlobalInstance(); }
+
+S21MatrixAllocator& S21MatrixAllocator::Pool() { return PoolInstance(); }
+
+S21MatrixAllocatorStats S21MatrixAllocator::GetStats() {
+  return {allocations.load(std::memory_order_relaxed),
+          pool_hits.load(std::memory_order_relaxed),
+          pool_misses.load(std::memory_order_relaxed),
+          arena_allocations.load(std::memory_order_relaxed),
+          system_allocations.load(std::memory_order_relaxed)};
+}
+
+void S21MatrixAllocator::ResetStats() {
+  allocations.store(0, std::memory_order_relaxed);
+  pool_hits.store(0, std::memory_order_relaxed);
+  pool_misses.store(0, std::memory_order_relaxed);
+  arena_allocations.store(0, std::memory_order_relaxed);
+  system_allocations.store(0, std::memory_order_relaxed);
+}
+
+S21MatrixAllocatorScope::S21MatrixAllocatorScope(
+    S21MatrixAllocator& allocator)
+    : previous_(tls_current) {
+  tls_current = &allocator;
+}
+
+S21MatrixAllocatorScope::~S21MatrixAllocatorScope() {
+  tls_current = previous_;
+}
+
+/**
+ * @brief Открывает арену и делает её текущим распределителем потока.
+ *
+ * @param chunk_bytes Размер куска, запрашиваемого у ::operator new.
+ */
+S21MatrixArena::S21MatrixArena(std::size_t chunk_bytes)
+    : resource_(new ArenaResource(chunk_bytes)), previous_(tls_current) {
+  tls_current = resource_;
+}
+
+/**
+ * @brief Восстанавливает прежний распределитель. Память арены
+ * освобождается, когда освобождён и последний её блок.
+ */
+S21MatrixArena::~S21MatrixArena() {
+  tls_current = previous_;
+  static_cast<ArenaResource*>(resource_)->Release();
+}
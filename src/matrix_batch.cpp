@@ -0,0 +1,523 @@
+/**
+ * @file matrix_batch.cpp
+ * @brief Реализация пакетов матриц S21BasicMatrixBatch.
+ *
+ * Ядра обрабатывают блок из kLanes матриц: внешние циклы идут по элементам
+ * матрицы, внутренний - по позициям блока, без ветвлений, поэтому
+ * компилятор переводит его в векторные инструкции. Выбор ведущего элемента
+ * тоже выполняется без ветвлений: строка k поочерёдно сравнивается с
+ * каждой нижней и в тех позициях, где нижний элемент больше по модулю,
+ * строки меняются местами выбором (select). После прохода в строке k
+ * оказывается наибольший элемент столбца, как при частичном выборе.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_batch.h"
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+using s21::kernels::kGemmParallelVolume;
+
+/**
+ * @brief c = a * b для блока матриц (m x k) * (k x n).
+ */
+template <typename T, int L>
+void MulBlock(const T* a, const T* b, T* c, int m, int k, int n) {
+  using Accumulator = typename s21::kernels::GemmTraits<T>::Accumulator;
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      Accumulator acc[L] = {};
+      for (int p = 0; p < k; ++p) {
+        const T* a_lanes = a + (i * k + p) * L;
+        const T* b_lanes = b + (p * n + j) * L;
+        for (int l = 0; l < L; ++l) {
+          acc[l] += static_cast<Accumulator>(a_lanes[l]) *
+                    static_cast<Accumulator>(b_lanes[l]);
+        }
+      }
+      T* c_lanes = c + (i * n + j) * L;
+      for (int l = 0; l < L; ++l) {
+        c_lanes[l] = static_cast<T>(acc[l]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Меняет местами в каждой матрице блока строку k со строкой
+ * pivot[l] в столбцах first..n - 1.
+ *
+ * При pivot[l] = k позиция меняется сама с собой.
+ */
+template <typename W, int L>
+void SwapRows(W* a, int n, int k, int first, const int* pivot) {
+  for (int c = first; c < n; ++c) {
+    W* upper = a + (k * n + c) * L;
+    for (int l = 0; l < L; ++l) {
+      W* lower = a + (pivot[l] * n + c) * L + l;
+      const W u = upper[l];
+      upper[l] = *lower;
+      *lower = u;
+    }
+  }
+}
+
+/**
+ * @brief Ставит в строку k блока наибольший по модулю элемент столбца k.
+ *
+ * Сначала без ветвлений находится номер ведущей строки каждой матрицы,
+ * затем строки меняются одним проходом по столбцам first..n - 1. Номера
+ * ведущих строк записываются в pivot, знак перестановки каждой матрицы
+ * обновляется в sign.
+ */
+template <typename W, int L>
+void SelectPivot(W* a, int n, int k, int first, int* pivot, W* sign) {
+  W best[L];
+  for (int l = 0; l < L; ++l) {
+    pivot[l] = k;
+    best[l] = std::fabs(a[(k * n + k) * L + l]);
+  }
+  for (int r = k + 1; r < n; ++r) {
+    const W* column = a + (r * n + k) * L;
+    for (int l = 0; l < L; ++l) {
+      const W value = std::fabs(column[l]);
+      const bool larger = value > best[l];
+      best[l] = larger ? value : best[l];
+      pivot[l] = larger ? r : pivot[l];
+    }
+  }
+  for (int l = 0; l < L; ++l) {
+    sign[l] = pivot[l] != k ? -sign[l] : sign[l];
+  }
+  SwapRows<W, L>(a, n, k, first, pivot);
+}
+
+/**
+ * @brief Определители блока матриц n x n исключением Гаусса.
+ *
+ * @param work Рабочий буфер n * n * L, портится.
+ */
+template <typename T, typename W, int L>
+void DeterminantBlock(const T* src, int n, W* work, double* result) {
+  for (int x = 0; x < n * n * L; ++x) {
+    work[x] = static_cast<W>(src[x]);
+  }
+  W det[L];
+  std::fill(det, det + L, W{1});
+  for (int k = 0; k < n; ++k) {
+    // левее k у строк ниже k всё уже исключено
+    int pivot[L];
+    SelectPivot<W, L>(work, n, k, k, pivot, det);
+    W inverse[L];
+    for (int l = 0; l < L; ++l) {
+      const W pivot = work[(k * n + k) * L + l];
+      det[l] *= pivot;
+      inverse[l] = pivot != W{0} ? W{1} / pivot : W{0};
+    }
+    for (int r = k + 1; r < n; ++r) {
+      W factor[L];
+      for (int l = 0; l < L; ++l) {
+        factor[l] = work[(r * n + k) * L + l] * inverse[l];
+      }
+      for (int c = k + 1; c < n; ++c) {
+        W* dst = work + (r * n + c) * L;
+        const W* pivot_row = work + (k * n + c) * L;
+        for (int l = 0; l < L; ++l) {
+          dst[l] -= factor[l] * pivot_row[l];
+        }
+      }
+    }
+  }
+  for (int l = 0; l < L; ++l) {
+    result[l] = static_cast<double>(det[l]);
+  }
+}
+
+/**
+ * @brief Обращает блок матриц n x n методом Гаусса-Жордана на месте.
+ *
+ * Обратная матрица строится в столбцах, уже исключённых из a, поэтому
+ * отдельная единичная матрица не нужна и на каждом шаге обновляются n
+ * столбцов вместо 2n - k. Перестановки строк при выборе ведущего элемента
+ * в конце отменяются перестановками столбцов в обратном порядке.
+ *
+ * @param a Блок; заменяется обратными матрицами.
+ * @param pivots Рабочий буфер n * L номеров ведущих строк.
+ * @param ratio Отношение наименьшего ведущего элемента к наибольшему для
+ * каждой матрицы, как S21BasicMatrixLU::PivotRatio.
+ */
+template <typename W, int L>
+void InverseBlock(W* a, int n, int* pivots, W* ratio) {
+  W sign[L];  // не нужен, но SelectPivot его обновляет
+  std::fill(sign, sign + L, W{1});
+  W min_pivot[L];
+  W max_pivot[L];
+  std::fill(min_pivot, min_pivot + L, std::numeric_limits<W>::infinity());
+  std::fill(max_pivot, max_pivot + L, W{0});
+  for (int k = 0; k < n; ++k) {
+    SelectPivot<W, L>(a, n, k, 0, pivots + k * L, sign);
+    W scale[L];
+    W* diagonal = a + (k * n + k) * L;
+    for (int l = 0; l < L; ++l) {
+      const W pivot = diagonal[l];
+      min_pivot[l] = std::min(min_pivot[l], std::fabs(pivot));
+      max_pivot[l] = std::max(max_pivot[l], std::fabs(pivot));
+      scale[l] = pivot != W{0} ? W{1} / pivot : W{0};
+      diagonal[l] = W{1};
+    }
+    for (int c = 0; c < n; ++c) {
+      W* row = a + (k * n + c) * L;
+      for (int l = 0; l < L; ++l) {
+        row[l] *= scale[l];
+      }
+    }
+    for (int r = 0; r < n; ++r) {
+      if (r == k) {
+        continue;
+      }
+      W factor[L];
+      W* column = a + (r * n + k) * L;
+      for (int l = 0; l < L; ++l) {
+        factor[l] = column[l];
+        column[l] = W{0};
+      }
+      for (int c = 0; c < n; ++c) {
+        W* dst = a + (r * n + c) * L;
+        const W* pivot_row = a + (k * n + c) * L;
+        for (int l = 0; l < L; ++l) {
+          dst[l] -= factor[l] * pivot_row[l];
+        }
+      }
+    }
+  }
+  for (int k = n - 1; k >= 0; --k) {
+    const int* pivot = pivots + k * L;
+    for (int r = 0; r < n; ++r) {
+      W* row = a + r * n * L;
+      for (int l = 0; l < L; ++l) {
+        std::swap(row[k * L + l], row[pivot[l] * L + l]);
+      }
+    }
+  }
+  for (int l = 0; l < L; ++l) {
+    ratio[l] = max_pivot[l] == W{0} ? W{0} : min_pivot[l] / max_pivot[l];
+  }
+}
+
+}  // namespace
+
+/**
+ * @brief Создаёт пустой пакет.
+ */
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch()
+    : count_(0), rows_(0), cols_(0) {}
+
+/**
+ * @brief Создаёт пакет из count нулевых матриц rows x cols.
+ *
+ * @throws std::invalid_argument Если размеры отрицательные.
+ */
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols) {
+  if (count < 0 || rows < 0 || cols < 0) {
+    throw std::invalid_argument("Batch dimensions must be non-negative");
+  }
+  data_.assign(static_cast<std::size_t>(Blocks()) * BlockSize(), T{0});
+  FillPadding();
+}
+
+/**
+ * @brief Создаёт пакет без обнуления элементов.
+ *
+ * Для результатов, которые операция записывает целиком, включая
+ * матрицы-заполнители последнего блока.
+ */
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols,
+                                            Uninitialized)
+    : count_(count), rows_(rows), cols_(cols) {
+  data_.resize(static_cast<std::size_t>(Blocks()) * BlockSize());
+}
+
+/**
+ * @brief Собирает пакет из матриц одного размера.
+ *
+ * @throws std::invalid_argument Если размеры матриц различаются.
+ */
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(
+    const std::vector<S21BasicMatrix<T>>& matrices)
+    : S21BasicMatrixBatch(
+          static_cast<int>(matrices.size()),
+          matrices.empty() ? 0 : matrices.front().GetRows(),
+          matrices.empty() ? 0 : matrices.front().GetCols()) {
+  for (int index = 0; index < count_; ++index) {
+    Set(index, matrices[index]);
+  }
+}
+
+/**
+ * @brief Возвращает копию матрицы index.
+ *
+ * @throws std::out_of_range Если номера нет в пакете.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::Get(int index) const {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Index is out of batch bounds");
+  }
+  S21BasicMatrix<T> matrix(rows_, cols_);
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      matrix(i, j) = (*this)(index, i, j);
+    }
+  }
+  return matrix;
+}
+
+/**
+ * @brief Записывает матрицу на место матрицы index.
+ *
+ * @throws std::out_of_range Если номера нет в пакете.
+ * @throws std::invalid_argument Если размер матрицы не совпадает с
+ * размером матриц пакета.
+ */
+template <typename T>
+void S21BasicMatrixBatch<T>::Set(int index, const S21BasicMatrix<T>& matrix) {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Index is out of batch bounds");
+  }
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::invalid_argument(
+        "Matrix must have the same dimensions as the batch");
+  }
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      (*this)(index, i, j) = matrix(i, j);
+    }
+  }
+}
+
+/**
+ * @brief Прибавляет к каждой матрице матрицу other с тем же номером.
+ *
+ * @throws std::invalid_argument Если пакеты различаются числом или
+ * размером матриц.
+ */
+template <typename T>
+void S21BasicMatrixBatch<T>::SumMatrix(const S21BasicMatrixBatch& other) {
+  if (count_ != other.count_ || rows_ != other.rows_ ||
+      cols_ != other.cols_) {
+    throw std::invalid_argument(
+        "Batches must have the same count and dimensions for addition");
+  }
+  const std::size_t block = BlockSize();
+  S21ThreadPool::Instance().ParallelForRanges(
+      Blocks(), static_cast<long long>(data_.size()), kGemmParallelVolume, 1,
+      [&](int begin, int end) {
+        T* dst = data_.data();
+        const T* src = other.data_.data();
+        for (std::size_t x = begin * block; x < end * block; ++x) {
+          dst[x] += src[x];
+        }
+      });
+  FillPadding();
+}
+
+/**
+ * @brief Умножает каждую матрицу на матрицу other с тем же номером.
+ *
+ * @throws std::invalid_argument Если пакеты различаются числом матриц или
+ * число столбцов матриц пакета не равно числу строк матриц other.
+ */
+template <typename T>
+void S21BasicMatrixBatch<T>::MulMatrix(const S21BasicMatrixBatch& other) {
+  if (count_ != other.count_ || cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Batches must have the same count and the number of columns in the "
+        "first batch must be equal to the number of rows in the second batch "
+        "for multiplication");
+  }
+  const std::size_t a_block = BlockSize();
+  const std::size_t b_block = other.BlockSize();
+  const long long volume =
+      static_cast<long long>(count_) * rows_ * cols_ * other.cols_;
+  if (other.cols_ == cols_) {
+    // размер не меняется: блок считается во временный буфер и копируется
+    // на место, без нового буфера на весь пакет
+    S21ThreadPool::Instance().ParallelForRanges(
+        Blocks(), volume, kGemmParallelVolume, 1, [&](int begin, int end) {
+          std::vector<T> block(a_block);
+          for (int b = begin; b < end; ++b) {
+            MulBlock<T, kLanes>(data_.data() + b * a_block,
+                                other.data_.data() + b * b_block, block.data(),
+                                rows_, cols_, cols_);
+            std::copy(block.begin(), block.end(), data_.begin() + b * a_block);
+          }
+        });
+    return;
+  }
+  S21BasicMatrixBatch result(count_, rows_, other.cols_, Uninitialized{});
+  const std::size_t c_block = result.BlockSize();
+  S21ThreadPool::Instance().ParallelForRanges(
+      Blocks(), volume, kGemmParallelVolume, 1, [&](int begin, int end) {
+        for (int b = begin; b < end; ++b) {
+          MulBlock<T, kLanes>(data_.data() + b * a_block,
+                              other.data_.data() + b * b_block,
+                              result.data_.data() + b * c_block, rows_, cols_,
+                              other.cols_);
+        }
+      });
+  result.FillPadding();
+  *this = std::move(result);
+}
+
+/**
+ * @brief Возвращает пакет транспонированных матриц.
+ */
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::Transpose() const {
+  S21BasicMatrixBatch result(count_, cols_, rows_, Uninitialized{});
+  const std::size_t block = BlockSize();
+  S21ThreadPool::Instance().ParallelForRanges(
+      Blocks(), static_cast<long long>(data_.size()), kGemmParallelVolume, 1,
+      [&](int begin, int end) {
+        for (int b = begin; b < end; ++b) {
+          const T* src = data_.data() + b * block;
+          T* dst = result.data_.data() + b * block;
+          for (int i = 0; i < rows_; ++i) {
+            for (int j = 0; j < cols_; ++j) {
+              std::copy(src + (i * cols_ + j) * kLanes,
+                        src + (i * cols_ + j + 1) * kLanes,
+                        dst + (j * rows_ + i) * kLanes);
+            }
+          }
+        }
+      });
+  return result;
+}
+
+/**
+ * @brief Вычисляет определители всех матриц пакета.
+ *
+ * Исключение Гаусса с частичным выбором, как у S21BasicMatrixLU; целые
+ * матрицы обрабатываются в double.
+ *
+ * @return Определители в порядке номеров матриц.
+ * @throws std::logic_error Если матрицы не квадратные.
+ */
+template <typename T>
+std::vector<double> S21BasicMatrixBatch<T>::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::logic_error(
+        "Matrix must be square to calculate its determinant");
+  }
+  using Work = std::conditional_t<std::is_floating_point_v<T>, T, double>;
+  const int n = rows_;
+  std::vector<double> result(static_cast<std::size_t>(Blocks()) * kLanes);
+  S21ThreadPool::Instance().ParallelForRanges(
+      Blocks(), static_cast<long long>(count_) * n * n * n,
+      kGemmParallelVolume, 1, [&](int begin, int end) {
+        std::vector<Work> work(BlockSize());
+        for (int b = begin; b < end; ++b) {
+          DeterminantBlock<T, Work, kLanes>(data_.data() + b * BlockSize(),
+                                            n, work.data(),
+                                            result.data() + b * kLanes);
+        }
+      });
+  result.resize(count_);
+  return result;
+}
+
+/**
+ * @brief Возвращает пакет обратных матриц.
+ *
+ * Метод Гаусса-Жордана с частичным выбором; вырожденность определяется,
+ * как в S21BasicMatrixLU::IsSingular, по отношению ведущих элементов.
+ *
+ * @return Пакет обратных матриц.
+ * @throws std::logic_error Если матрицы не квадратные, какая-либо из них
+ * вырождена (в сообщении - номер первой такой), а также для целых матриц.
+ */
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseMatrix() const {
+  if constexpr (std::is_integral_v<T>) {
+    throw std::logic_error(
+        "Matrix inverse requires a floating-point element type");
+  } else {
+    if (rows_ != cols_) {
+      throw std::logic_error("Matrix must be square to calculate its inverse");
+    }
+    const int n = rows_;
+    const T threshold = n * std::numeric_limits<T>::epsilon();
+    S21BasicMatrixBatch result(count_, n, n, Uninitialized{});
+    // первая вырожденная матрица каждого блока или -1
+    std::vector<int> singular(Blocks(), -1);
+    S21ThreadPool::Instance().ParallelForRanges(
+        Blocks(), 2LL * count_ * n * n * n, kGemmParallelVolume, 1,
+        [&](int begin, int end) {
+          std::vector<int> pivots(static_cast<std::size_t>(n) * kLanes);
+          T ratio[kLanes];
+          for (int b = begin; b < end; ++b) {
+            T* block = result.data_.data() + b * BlockSize();
+            std::copy(data_.begin() + b * BlockSize(),
+                      data_.begin() + (b + 1) * BlockSize(), block);
+            InverseBlock<T, kLanes>(block, n, pivots.data(), ratio);
+            for (int l = kLanes - 1; l >= 0; --l) {
+              if (!(ratio[l] > threshold)) {
+                singular[b] = b * kLanes + l;
+              }
+            }
+          }
+        });
+    for (int index : singular) {
+      if (index >= 0) {
+        throw std::logic_error("Matrix " + std::to_string(index) +
+                               " of the batch is singular, its inverse "
+                               "cannot be calculated");
+      }
+    }
+    return result;
+  }
+}
+
+/**
+ * @brief Сравнивает пакеты поэлементно.
+ */
+template <typename T>
+bool S21BasicMatrixBatch<T>::operator==(
+    const S21BasicMatrixBatch& other) const {
+  return count_ == other.count_ && rows_ == other.rows_ &&
+         cols_ == other.cols_ && data_ == other.data_;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::FillPadding() {
+  if (count_ % kLanes == 0) {
+    return;
+  }
+  T* last = data_.data() + static_cast<std::size_t>(Blocks() - 1) * BlockSize();
+  for (int i = 0; i < rows_; ++i) {
+    for (int j = 0; j < cols_; ++j) {
+      std::fill(last + (i * cols_ + j) * kLanes + count_ % kLanes,
+                last + (i * cols_ + j + 1) * kLanes,
+                i == j ? T{1} : T{0});
+    }
+  }
+}
+
+#define S21_INSTANTIATE_BATCH(T) template class S21BasicMatrixBatch<T>;
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_BATCH)
+#undef S21_INSTANTIATE_BATCH
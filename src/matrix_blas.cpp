@@ -0,0 +1,229 @@
+/**
+ * @file matrix_blas.cpp
+ * @brief Операции в стиле BLAS: C = alpha * op(A) * op(B) + beta * C и
+ * y = alpha * op(A) * x + beta * y с записью в существующий приёмник.
+ *
+ * Транспонирование множителя не копирует его: ядра читают матрицу с
+ * переставленными шагами. На этих же путях построены MulMatrix и operator*.
+ */
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_stats.h"
+
+namespace {
+
+/**
+ * @brief Возвращает op(matrix) в виде ссылки с шагами для ядер.
+ */
+template <typename T>
+s21::kernels::ConstMatrixRef<T> Operand(const S21BasicMatrix<T>& matrix,
+                                        S21MatrixTranspose trans) {
+  if (trans == S21MatrixTranspose::kTranspose) {
+    return {matrix.data(), 1, matrix.GetStride()};
+  }
+  return {matrix.data(), matrix.GetStride(), 1};
+}
+
+// число строк и столбцов op(matrix)
+template <typename T>
+int OpRows(const S21BasicMatrix<T>& matrix, S21MatrixTranspose trans) {
+  return trans == S21MatrixTranspose::kNone ? matrix.GetRows()
+                                            : matrix.GetCols();
+}
+template <typename T>
+int OpCols(const S21BasicMatrix<T>& matrix, S21MatrixTranspose trans) {
+  return trans == S21MatrixTranspose::kNone ? matrix.GetCols()
+                                            : matrix.GetRows();
+}
+
+/**
+ * @brief Проверяет, что matrix - строка или столбец из length элементов.
+ */
+template <typename T>
+bool IsVector(const S21BasicMatrix<T>& matrix, int length) {
+  return (matrix.GetRows() == 1 && matrix.GetCols() == length) ||
+         (matrix.GetCols() == 1 && matrix.GetRows() == length);
+}
+
+/**
+ * @brief Возвращает шаг между элементами вектора: у столбца - шаг строки.
+ */
+template <typename T>
+std::ptrdiff_t Increment(const S21BasicMatrix<T>& vector) {
+  return vector.GetCols() == 1 ? vector.GetStride() : 1;
+}
+
+}  // namespace
+
+/**
+ * @brief Вычисляет C = alpha * op(A) * op(B) + beta * C на месте.
+ *
+ * Результат пишется прямо в буфер C: в отличие от c += a * b не создаются
+ * ни произведение, ни копия, а beta * C прибавляет микроядро GEMM при
+ * первой записи тайла, без отдельного прохода по C. При beta = 0 исходное
+ * содержимое C не читается. Для квадратных вещественных op(A) и op(B) со
+ * стороной больше GetStrassenCrossover() и beta = 0 используется
+ * Штрассен-Виноград, как в MulMatrix; alpha != 1 тогда применяется
+ * отдельным проходом. Если C совпадает с A или B, множитель предварительно
+ * копируется.
+ *
+ * @param alpha Множитель произведения.
+ * @param a Матрица A.
+ * @param b Матрица B.
+ * @param beta Множитель исходного содержимого C.
+ * @param c Приёмник размера op(A).rows x op(B).cols.
+ * @param trans_a Транспонирование A.
+ * @param trans_b Транспонирование B.
+ * @throws std::invalid_argument Если число столбцов op(A) не равно числу
+ * строк op(B) или размер C не совпадает с размером произведения.
+ */
+template <typename T>
+void S21BasicMatrix<T>::Gemm(T alpha, const S21BasicMatrix& a,
+                             const S21BasicMatrix& b, T beta,
+                             S21BasicMatrix& c, S21MatrixTranspose trans_a,
+                             S21MatrixTranspose trans_b) {
+  const int m = OpRows(a, trans_a);
+  const int n = OpCols(b, trans_b);
+  const int k = OpCols(a, trans_a);
+  if (OpRows(b, trans_b) != k) {
+    throw std::invalid_argument(
+        "Number of columns of op(A) must be equal to the number of rows of "
+        "op(B) for Gemm");
+  }
+  if (c.rows_ != m || c.cols_ != n) {
+    throw std::invalid_argument(
+        "Matrix C must have the dimensions of op(A) * op(B) for Gemm");
+  }
+  if (&c == &a || &c == &b) {
+    // ядро перезаписывало бы элементы множителя, которые ещё не прочитаны
+    const S21BasicMatrix source(c);
+    Gemm(alpha, &a == &c ? source : a, &b == &c ? source : b, beta, c,
+         trans_a, trans_b);
+    return;
+  }
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kGemm, 2 * c.Elements() * k,
+                         sizeof(T) * (a.Elements() + b.Elements() +
+                                      2 * c.Elements()));
+
+  MultiplyInto(alpha, a, trans_a, b, trans_b, beta, c,
+               S21MatrixMulAlgorithm::kAuto);
+}
+
+/**
+ * @brief Вычисляет y = alpha * op(A) * x + beta * y на месте.
+ *
+ * x и y могут быть как строками, так и столбцами; столбцы читаются с шагом
+ * строки без копирования. При beta = 0 исходное содержимое y не
+ * читается. Если y совпадает с A или x, они предварительно копируются.
+ *
+ * @param alpha Множитель произведения.
+ * @param a Матрица A.
+ * @param x Вектор из op(A).cols элементов.
+ * @param beta Множитель исходного содержимого y.
+ * @param y Вектор-приёмник из op(A).rows элементов.
+ * @param trans_a Транспонирование A.
+ * @throws std::invalid_argument Если x или y не являются строкой или
+ * столбцом подходящей длины.
+ */
+template <typename T>
+void S21BasicMatrix<T>::Gemv(T alpha, const S21BasicMatrix& a,
+                             const S21BasicMatrix& x, T beta,
+                             S21BasicMatrix& y, S21MatrixTranspose trans_a) {
+  const int m = OpRows(a, trans_a);
+  const int n = OpCols(a, trans_a);
+  if (!IsVector(x, n)) {
+    throw std::invalid_argument(
+        "Vector x must be a row or a column with as many elements as op(A) "
+        "has columns for Gemv");
+  }
+  if (!IsVector(y, m)) {
+    throw std::invalid_argument(
+        "Vector y must be a row or a column with as many elements as op(A) "
+        "has rows for Gemv");
+  }
+  if (&y == &a || &y == &x) {
+    const S21BasicMatrix source(y);
+    Gemv(alpha, &a == &y ? source : a, &x == &y ? source : x, beta, y,
+         trans_a);
+    return;
+  }
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kGemv, 2 * a.Elements(),
+                         sizeof(T) * (a.Elements() + n + 2ull * m));
+
+  s21::kernels::Gemv<T>(m, n, alpha, Operand(a, trans_a), x.matrix_,
+                        Increment(x), beta, y.matrix_, Increment(y));
+}
+
+/**
+ * @brief Вычисляет c = alpha * op(a) * op(b) + beta * c.
+ *
+ * При kAuto Штрассен-Виноград выбирается для квадратных вещественных
+ * множителей со стороной больше GetStrassenCrossover(): хотя бы один
+ * уровень рекурсии. Схема перезаписывает c, поэтому используется только
+ * при beta = 0, а alpha применяется отдельным проходом. Целые матрицы
+ * всегда умножаются блочным GEMM, произведение на столбец считает GEMV.
+ * Размеры должны быть проверены вызывающим методом, c не должна совпадать
+ * с a или b.
+ *
+ * @param alpha Множитель произведения.
+ * @param a Левый множитель.
+ * @param trans_a Транспонирование a.
+ * @param b Правый множитель.
+ * @param trans_b Транспонирование b.
+ * @param beta Множитель исходного содержимого c.
+ * @param c Приёмник.
+ * @param algorithm Алгоритм умножения.
+ */
+template <typename T>
+void S21BasicMatrix<T>::MultiplyInto(T alpha, const S21BasicMatrix& a,
+                                     S21MatrixTranspose trans_a,
+                                     const S21BasicMatrix& b,
+                                     S21MatrixTranspose trans_b, T beta,
+                                     S21BasicMatrix& c,
+                                     S21MatrixMulAlgorithm algorithm) {
+  const int k = OpCols(a, trans_a);
+  if (c.cols_ == 1) {
+    // op(b) - столбец: упаковка GEMM не окупается, GEMV читает A один раз
+    s21::kernels::Gemv<T>(c.rows_, k, alpha, Operand(a, trans_a), b.matrix_,
+                          trans_b == S21MatrixTranspose::kNone ? b.stride_ : 1,
+                          beta, c.matrix_, c.stride_);
+    return;
+  }
+  if constexpr (std::is_floating_point_v<T>) {
+    const int crossover = GetStrassenCrossover();
+    const bool square = c.rows_ == k && k == c.cols_;
+    if (beta == T{0} &&
+        (algorithm == S21MatrixMulAlgorithm::kStrassen ||
+         (algorithm == S21MatrixMulAlgorithm::kAuto && square &&
+          c.rows_ > crossover))) {
+      s21::kernels::Strassen<T>(c.rows_, c.cols_, k, Operand(a, trans_a),
+                                Operand(b, trans_b), c.matrix_, c.stride_,
+                                crossover);
+      if (alpha != T{1}) {
+        s21::kernels::Scale(c.matrix_, alpha, c.BufferSize());
+      }
+      return;
+    }
+  }
+  s21::kernels::Gemm<T>(c.rows_, c.cols_, k, alpha, Operand(a, trans_a),
+                        Operand(b, trans_b), beta, c.matrix_, c.stride_);
+}
+
+#define S21_INSTANTIATE_BLAS(T)                                            \
+  template void S21BasicMatrix<T>::Gemm(                                   \
+      T, const S21BasicMatrix<T>&, const S21BasicMatrix<T>&, T,            \
+      S21BasicMatrix<T>&, S21MatrixTranspose, S21MatrixTranspose);         \
+  template void S21BasicMatrix<T>::Gemv(T, const S21BasicMatrix<T>&,       \
+                                        const S21BasicMatrix<T>&, T,       \
+                                        S21BasicMatrix<T>&,                \
+                                        S21MatrixTranspose);               \
+  template void S21BasicMatrix<T>::MultiplyInto(                           \
+      T, const S21BasicMatrix<T>&, S21MatrixTranspose,                     \
+      const S21BasicMatrix<T>&, S21MatrixTranspose, T, S21BasicMatrix<T>&, \
+      S21MatrixMulAlgorithm);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_BLAS)
+#undef S21_INSTANTIATE_BLAS
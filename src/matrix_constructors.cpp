@@ -1,61 +1,218 @@
 /**
  * @file matrix_constructors.cpp
- * @brief Реализация конструкторов и деструктора класса S21Matrix
+ * @brief Реализация конструкторов и деструктора класса S21BasicMatrix
  *
  * Данный файл содержит реализацию базового конструктора, параметризированного
  * конструктора, конструктора копирования, конструктора переноса и деструктора
- * класса S21Matrix.
+ * класса S21BasicMatrix, а также размещение буфера: во встроенном буфере
+ * объекта для малых матриц или у распределителя для остальных.
  */
 
+#include <cstring>
+#include <new>
+#include <stdexcept>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_kernels.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_stats.h"
 
 /**
- * @brief Базовый конструктор класса S21Matrix.
+ * @brief Базовый конструктор класса S21BasicMatrix.
  *
  * Инициализирует матрицу нулевой размерности (0x0).
  */
-S21Matrix::S21Matrix() : rows_(0), cols_(0) {}
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix()
+    : rows_(0), cols_(0), stride_(0), matrix_(nullptr) {}
 
 /**
- * @brief Параметризированный конструктор класса S21Matrix.
+ * @brief Параметризированный конструктор класса S21BasicMatrix.
  *
- * Создает матрицу заданных размеров (rows x cols).
+ * Создает матрицу заданных размеров (rows x cols). Матрица из не более чем
+ * kInlineCapacity элементов размещается во встроенном буфере без обращения
+ * к распределителю.
  *
  * @param rows Количество строк матрицы.
  * @param cols Количество столбцов матрицы.
  */
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
-  matrix_.resize(rows_);
-  for (int i = 0; i < rows_; ++i) {
-    matrix_[i].resize(cols_);
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols), stride_(0), matrix_(nullptr) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("Matrix dimensions must be non-negative");
+  }
+  if (FitsInline(rows_, cols_)) {
+    // малой матрице выравнивание строк не нужно, шаг - без заполнения
+    stride_ = cols_;
+    matrix_ = inline_;
+    std::memset(matrix_, 0, sizeof(T) * BufferSize());
+  } else {
+    stride_ = CalcStride(cols_);
+    matrix_ = Allocate(BufferSize());
   }
 }
 
 /**
- * @brief Конструктор копирования класса S21Matrix.
+ * @brief Конструктор копирования класса S21BasicMatrix.
  *
  * Создает копию существующей матрицы.
  *
  * @param other Ссылка на матрицу, которую нужно скопировать.
  */
-S21Matrix::S21Matrix(const S21Matrix& other)
-    : rows_(other.rows_), cols_(other.cols_), matrix_(other.matrix_) {}
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other)
+    : rows_(other.rows_),
+      cols_(other.cols_),
+      stride_(other.stride_),
+      matrix_(nullptr) {
+  // буфер выделяется в теле, чтобы выделение попало в счётчик копирования
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kCopyConstructor, 0,
+                         2 * sizeof(T) * Elements());
+  matrix_ = other.IsInline() ? inline_ : Allocate(BufferSize());
+  if (matrix_ != nullptr) {
+    std::memcpy(matrix_, other.matrix_, sizeof(T) * BufferSize());
+  }
+}
 
 /**
- * @brief Конструктор переноса класса S21Matrix.
+ * @brief Конструктор переноса класса S21BasicMatrix.
  *
- * Переносит содержимое другой матрицы в новую матрицу.
+ * Переносит содержимое другой матрицы в новую матрицу: буфер в куче
+ * забирается, встроенный копируется.
  *
  * @param other Ссылка на матрицу, содержимое которой нужно перенести.
  */
-S21Matrix::S21Matrix(S21Matrix&& other)
-    : rows_(other.rows_),
-      cols_(other.cols_),
-      matrix_(std::move(other.matrix_)) {}
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept
+    : rows_(0), cols_(0), stride_(0), matrix_(nullptr) {
+  Steal(other);
+}
 
 /**
- * @brief Деструктор класса S21Matrix.
+ * @brief Деструктор класса S21BasicMatrix.
  *
  * Освобождает память, занятую матрицей, по завершении работы с ней.
  */
-S21Matrix::~S21Matrix() {}
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() { Release(); }
+
+/**
+ * @brief Освобождает буфер матрицы, если он выделен в куче.
+ *
+ * Поля размеров не меняются: вызывающий код сразу заполняет их заново.
+ */
+template <typename T>
+void S21BasicMatrix<T>::Release() noexcept {
+  if (!IsInline()) {
+    Deallocate(matrix_);
+  }
+  matrix_ = nullptr;
+}
+
+/**
+ * @brief Забирает содержимое другой матрицы.
+ *
+ * Буфер в куче переходит без копирования, встроенный копируется в
+ * собственный встроенный буфер. other становится пустой матрицей 0x0.
+ *
+ * @param other Матрица-источник (не *this).
+ */
+template <typename T>
+void S21BasicMatrix<T>::Steal(S21BasicMatrix& other) noexcept {
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  stride_ = other.stride_;
+  if (other.IsInline()) {
+    std::memcpy(inline_, other.inline_, sizeof(T) * BufferSize());
+    matrix_ = inline_;
+  } else {
+    matrix_ = other.matrix_;
+  }
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.stride_ = 0;
+  other.matrix_ = nullptr;
+}
+
+/**
+ * @brief Вычисляет шаг строки для заданного числа столбцов.
+ *
+ * Шаг округляется вверх до kStrideAlign элементов, чтобы каждая строка
+ * начиналась с выровненного адреса.
+ *
+ * @param cols Количество столбцов.
+ * @return Шаг строки в элементах.
+ */
+template <typename T>
+int S21BasicMatrix<T>::CalcStride(int cols) {
+  return (cols + kStrideAlign - 1) / kStrideAlign * kStrideAlign;
+}
+
+/**
+ * @brief Проверяет, помещается ли матрица во встроенный буфер.
+ *
+ * @param rows Количество строк.
+ * @param cols Количество столбцов.
+ * @return true, если матрица непустая и в ней не больше kInlineCapacity
+ * элементов.
+ */
+template <typename T>
+bool S21BasicMatrix<T>::FitsInline(int rows, int cols) {
+  const long long count = static_cast<long long>(rows) * cols;
+  return count > 0 && count <= kInlineCapacity;
+}
+
+/**
+ * @brief Выделяет выровненный и обнулённый буфер под элементы матрицы.
+ *
+ * Память берётся у текущего распределителя потока. Перед данными лежит
+ * заголовок (kAlignment байт) с распределителем и размером блока, по
+ * которому Deallocate возвращает блок владельцу.
+ *
+ * @param count Количество элементов.
+ * @return Указатель на буфер или nullptr, если count равен нулю.
+ */
+template <typename T>
+T* S21BasicMatrix<T>::Allocate(std::size_t count) {
+  if (count == 0) {
+    return nullptr;
+  }
+  const std::size_t bytes = count * sizeof(T) + kAlignment;
+  S21MatrixAllocator& allocator = S21MatrixAllocator::Current();
+  S21_MATRIX_STATS_ALLOCATION();
+  char* block = static_cast<char*>(allocator.Allocate(bytes));
+  ::new (block) BlockHeader{&allocator, bytes};
+  T* data = reinterpret_cast<T*>(block + kAlignment);
+  std::memset(data, 0, count * sizeof(T));
+  return data;
+}
+
+/**
+ * @brief Освобождает буфер, выделенный Allocate.
+ *
+ * @param ptr Указатель на буфер (может быть nullptr).
+ */
+template <typename T>
+void S21BasicMatrix<T>::Deallocate(T* ptr) noexcept {
+  if (ptr != nullptr) {
+    char* block = reinterpret_cast<char*>(ptr) - kAlignment;
+    const BlockHeader header = *reinterpret_cast<BlockHeader*>(block);
+    header.allocator->Deallocate(block, header.bytes);
+  }
+}
+
+#define S21_INSTANTIATE_CONSTRUCTORS(T)                                     \
+  template S21BasicMatrix<T>::S21BasicMatrix();                             \
+  template S21BasicMatrix<T>::S21BasicMatrix(int, int);                     \
+  template S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix<T>&);     \
+  template S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix<T>&&) noexcept; \
+  template S21BasicMatrix<T>::~S21BasicMatrix();                            \
+  template void S21BasicMatrix<T>::Release() noexcept;                      \
+  template void S21BasicMatrix<T>::Steal(S21BasicMatrix<T>&) noexcept;      \
+  template int S21BasicMatrix<T>::CalcStride(int);                          \
+  template bool S21BasicMatrix<T>::FitsInline(int, int);                    \
+  template T* S21BasicMatrix<T>::Allocate(std::size_t);                     \
+  template void S21BasicMatrix<T>::Deallocate(T*) noexcept;
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_CONSTRUCTORS)
+#undef S21_INSTANTIATE_CONSTRUCTORS
@@ -0,0 +1,413 @@
+/**
+ * @file matrix_gemm.cpp
+ * @brief Блочное умножение матриц (GEMM) с упаковкой и регистровым микроядром
+ * и умножение матрицы на вектор (GEMV).
+ *
+ * Схема повторяет классическую декомпозицию GotoBLAS/BLIS: панель B размером
+ * kc x nc упаковывается в L3, блок A размером mc x kc - в L2, а микроядро
+ * kGemmMr x kGemmNr держит накопители в регистрах и читает упакованные данные
+ * строго последовательно. Большие произведения делятся на двумерные тайлы C,
+ * которые независимо считаются на потоках S21ThreadPool.
+ *
+ * Алгоритм один для всех типов элементов, отличаются параметры
+ * GemmTraits: ширина микроядра (16 столбцов для float, чтобы строка
+ * накопителей занимала те же 64 байта) и тип накопителя (long long для
+ * целых, чтобы суммы длиной k не переполнялись до записи в C).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "s21_matrix_kernels.h"
+#include "s21_thread_pool.h"
+
+namespace s21::kernels {
+
+namespace {
+
+/**
+ * @brief Масштабирует C на beta (при beta == 0 обнуляет, не читая C).
+ */
+template <typename T>
+void ScaleC(int m, int n, T beta, T* c, std::ptrdiff_t ldc) {
+  if (beta == T{1}) {
+    return;
+  }
+  for (int i = 0; i < m; ++i) {
+    T* c_row = c + i * ldc;
+    if (beta == T{0}) {
+      std::fill(c_row, c_row + n, T{0});
+    } else {
+      for (int j = 0; j < n; ++j) {
+        c_row[j] *= beta;
+      }
+    }
+  }
+}
+
+/**
+ * @brief Простой цикл i-k-j для маленьких матриц, где упаковка не окупается.
+ *
+ * beta применяется при первой записи строки C (p = 0), k > 0.
+ */
+template <typename T>
+void GemmSmall(int m, int n, int k, T alpha, ConstMatrixRef<T> a,
+               ConstMatrixRef<T> b, T beta, T* c, std::ptrdiff_t ldc) {
+  using Accumulator = typename GemmTraits<T>::Accumulator;
+  for (int i = 0; i < m; ++i) {
+    T* c_row = c + i * ldc;
+    const Accumulator ai0 = static_cast<Accumulator>(alpha) * a.At(i, 0);
+    if (beta == T{0}) {
+      for (int j = 0; j < n; ++j) {
+        c_row[j] = static_cast<T>(ai0 * b.At(0, j));
+      }
+    } else {
+      for (int j = 0; j < n; ++j) {
+        c_row[j] = static_cast<T>(static_cast<Accumulator>(beta) * c_row[j] +
+                                  ai0 * b.At(0, j));
+      }
+    }
+    for (int p = 1; p < k; ++p) {
+      const Accumulator aip = static_cast<Accumulator>(alpha) * a.At(i, p);
+      for (int j = 0; j < n; ++j) {
+        c_row[j] = static_cast<T>(c_row[j] + aip * b.At(p, j));
+      }
+    }
+  }
+}
+
+/**
+ * @brief Упаковывает блок A (mc x kc) в панели по kGemmMr строк.
+ *
+ * Внутри панели элементы идут столбец за столбцом, недостающие строки
+ * последней панели дополняются нулями. Множитель alpha применяется здесь,
+ * чтобы микроядру не приходилось его учитывать.
+ */
+template <typename T>
+void PackA(int mc, int kc, T alpha, ConstMatrixRef<T> a, int row0, int col0,
+           T* buffer) {
+  for (int ir = 0; ir < mc; ir += kGemmMr) {
+    const int mr = std::min(kGemmMr, mc - ir);
+    for (int p = 0; p < kc; ++p) {
+      for (int i = 0; i < mr; ++i) {
+        buffer[i] = alpha * a.At(row0 + ir + i, col0 + p);
+      }
+      for (int i = mr; i < kGemmMr; ++i) {
+        buffer[i] = T{0};
+      }
+      buffer += kGemmMr;
+    }
+  }
+}
+
+/**
+ * @brief Упаковывает панель B (kc x nc) в полосы по GemmTraits<T>::kNr
+ * столбцов.
+ */
+template <typename T>
+void PackB(int kc, int nc, ConstMatrixRef<T> b, int row0, int col0,
+           T* buffer) {
+  constexpr int kNr = GemmTraits<T>::kNr;
+  for (int jr = 0; jr < nc; jr += kNr) {
+    const int nr = std::min(kNr, nc - jr);
+    for (int p = 0; p < kc; ++p) {
+      for (int j = 0; j < nr; ++j) {
+        buffer[j] = b.At(row0 + p, col0 + jr + j);
+      }
+      for (int j = nr; j < kNr; ++j) {
+        buffer[j] = T{0};
+      }
+      buffer += kNr;
+    }
+  }
+}
+
+/**
+ * @brief Регистровое микроядро: C[mr x nr] = A_panel * B_panel + beta * C.
+ *
+ * Накопители kGemmMr x kNr живут в регистрах на всём протяжении kc,
+ * в память пишется только итоговый тайл; при beta = 0 C не читается.
+ */
+template <typename T>
+void MicroKernel(int kc, const T* a, const T* b, T beta, T* c,
+                 std::ptrdiff_t ldc, int mr, int nr) {
+  using Accumulator = typename GemmTraits<T>::Accumulator;
+  constexpr int kNr = GemmTraits<T>::kNr;
+  Accumulator acc[kGemmMr][kNr] = {};
+  for (int p = 0; p < kc; ++p) {
+    for (int i = 0; i < kGemmMr; ++i) {
+      const Accumulator ai = a[i];
+      for (int j = 0; j < kNr; ++j) {
+        acc[i][j] += ai * b[j];
+      }
+    }
+    a += kGemmMr;
+    b += kNr;
+  }
+
+  for (int i = 0; i < mr; ++i) {
+    T* c_row = c + i * ldc;
+    if (beta == T{0}) {
+      for (int j = 0; j < nr; ++j) {
+        c_row[j] = static_cast<T>(acc[i][j]);
+      }
+    } else {
+      for (int j = 0; j < nr; ++j) {
+        c_row[j] = static_cast<T>(static_cast<Accumulator>(beta) * c_row[j] +
+                                  acc[i][j]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Однопоточный GEMM: блочный цикл с упаковкой или простой цикл для
+ * маленьких матриц.
+ *
+ * beta применяется при записи тайла первой панели kc, остальные панели
+ * прибавляются к C; отдельный проход ScaleC нужен только без произведения
+ * (k = 0 или alpha = 0).
+ */
+template <typename T>
+void GemmSerial(int m, int n, int k, T alpha, ConstMatrixRef<T> a,
+                ConstMatrixRef<T> b, T beta, T* c, std::ptrdiff_t ldc) {
+  constexpr int kNr = GemmTraits<T>::kNr;
+  if (k <= 0 || alpha == T{0}) {
+    ScaleC(m, n, beta, c, ldc);
+    return;
+  }
+
+  if (static_cast<long long>(m) * n * k <= kGemmSmallVolume) {
+    GemmSmall(m, n, k, alpha, a, b, beta, c, ldc);
+    return;
+  }
+
+  const int nc_max = std::min(kGemmNc, (n + kNr - 1) / kNr * kNr);
+  const int mc_max = std::min(kGemmMc, (m + kGemmMr - 1) / kGemmMr * kGemmMr);
+  const int kc_max = std::min(kGemmKc, k);
+  std::vector<T> packed_b(static_cast<std::size_t>(kc_max) * nc_max);
+  std::vector<T> packed_a(static_cast<std::size_t>(kc_max) * mc_max);
+
+  for (int jc = 0; jc < n; jc += kGemmNc) {
+    const int nc = std::min(kGemmNc, n - jc);
+    for (int pc = 0; pc < k; pc += kGemmKc) {
+      const int kc = std::min(kGemmKc, k - pc);
+      const T beta_pc = pc == 0 ? beta : T{1};
+      PackB(kc, nc, b, pc, jc, packed_b.data());
+
+      for (int ic = 0; ic < m; ic += kGemmMc) {
+        const int mc = std::min(kGemmMc, m - ic);
+        PackA(mc, kc, alpha, a, ic, pc, packed_a.data());
+
+        for (int jr = 0; jr < nc; jr += kNr) {
+          const int nr = std::min(kNr, nc - jr);
+          const T* b_panel =
+              packed_b.data() + static_cast<std::ptrdiff_t>(jr) * kc;
+          for (int ir = 0; ir < mc; ir += kGemmMr) {
+            const int mr = std::min(kGemmMr, mc - ir);
+            const T* a_panel =
+                packed_a.data() + static_cast<std::ptrdiff_t>(ir) * kc;
+            T* c_tile = c + (ic + ir) * ldc + jc + jr;
+            MicroKernel(kc, a_panel, b_panel, beta_pc, c_tile, ldc, mr, nr);
+          }
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Возвращает alpha * sum + beta * y (при beta == 0 не читая y).
+ */
+template <typename T, typename Accumulator>
+T GemvResult(Accumulator sum, T alpha, T beta, T y) {
+  const Accumulator scaled = static_cast<Accumulator>(alpha) * sum;
+  return static_cast<T>(
+      beta == T{0} ? scaled : scaled + static_cast<Accumulator>(beta) * y);
+}
+
+/**
+ * @brief GEMV для kRows строк A с единичным шагом столбца, начиная с i.
+ *
+ * Каждая строка копится в kNr независимых накопителях, как строка
+ * микроядра GEMM; отрезок x с неединичным шагом сначала копируется на
+ * стек, чтобы умножение читало его подряд.
+ */
+template <int kRows, typename T>
+void GemvRowBlock(int i, int n, T alpha, ConstMatrixRef<T> a, const T* x,
+                  std::ptrdiff_t incx, T beta, T* y, std::ptrdiff_t incy) {
+  using Accumulator = typename GemmTraits<T>::Accumulator;
+  constexpr int kNr = GemmTraits<T>::kNr;
+  const T* a_rows = a.data + i * a.row_stride;
+  Accumulator acc[kRows][kNr] = {};
+  T x_block[kNr];
+  int j = 0;
+  for (; j + kNr <= n; j += kNr) {
+    const T* x_j = x + j * incx;
+    if (incx != 1) {
+      for (int l = 0; l < kNr; ++l) {
+        x_block[l] = x_j[l * incx];
+      }
+      x_j = x_block;
+    }
+    for (int r = 0; r < kRows; ++r) {
+      const T* a_r = a_rows + r * a.row_stride + j;
+      for (int l = 0; l < kNr; ++l) {
+        acc[r][l] += static_cast<Accumulator>(a_r[l]) * x_j[l];
+      }
+    }
+  }
+  for (int r = 0; r < kRows; ++r) {
+    const T* a_r = a_rows + r * a.row_stride;
+    Accumulator sum{0};
+    for (int l = 0; l < kNr; ++l) {
+      sum += acc[r][l];
+    }
+    for (int p = j; p < n; ++p) {
+      sum += static_cast<Accumulator>(a_r[p]) * x[p * incx];
+    }
+    T& y_r = y[(i + r) * incy];
+    y_r = GemvResult(sum, alpha, beta, y_r);
+  }
+}
+
+/**
+ * @brief GEMV для полосы y из kWidth элементов, начиная с i, когда строки
+ * A лежат с единичным шагом (A транспонирована).
+ *
+ * Полоса копится в регистрах, пока по ней проходят все n столбцов A:
+ * каждый столбец читается kWidth подряд идущими элементами.
+ */
+template <int kWidth, typename T>
+void GemvStrip(int i, int n, T alpha, ConstMatrixRef<T> a, const T* x,
+               std::ptrdiff_t incx, T beta, T* y, std::ptrdiff_t incy) {
+  using Accumulator = typename GemmTraits<T>::Accumulator;
+  Accumulator acc[kWidth] = {};
+  const T* a_strip = a.data + i;
+  for (int p = 0; p < n; ++p) {
+    const Accumulator x_p = x[p * incx];
+    const T* a_p = a_strip + p * a.col_stride;
+    for (int l = 0; l < kWidth; ++l) {
+      acc[l] += x_p * a_p[l];
+    }
+  }
+  for (int l = 0; l < kWidth; ++l) {
+    T& y_l = y[(i + l) * incy];
+    y_l = GemvResult(acc[l], alpha, beta, y_l);
+  }
+}
+
+/**
+ * @brief Однопоточный GEMV для элементов y с begin по end.
+ */
+template <typename T>
+void GemvRange(int begin, int end, int n, T alpha, ConstMatrixRef<T> a,
+               const T* x, std::ptrdiff_t incx, T beta, T* y,
+               std::ptrdiff_t incy) {
+  using Accumulator = typename GemmTraits<T>::Accumulator;
+  constexpr int kNr = GemmTraits<T>::kNr;
+  int i = begin;
+  if (n <= 0 || alpha == T{0}) {
+    for (; i < end; ++i) {
+      y[i * incy] = GemvResult(Accumulator{0}, alpha, beta, y[i * incy]);
+    }
+  } else if (a.col_stride == 1) {
+    for (; i + kGemmMr <= end; i += kGemmMr) {
+      GemvRowBlock<kGemmMr>(i, n, alpha, a, x, incx, beta, y, incy);
+    }
+    for (; i < end; ++i) {
+      GemvRowBlock<1>(i, n, alpha, a, x, incx, beta, y, incy);
+    }
+  } else if (a.row_stride == 1) {
+    for (; i + kGemmMr * kNr <= end; i += kGemmMr * kNr) {
+      GemvStrip<kGemmMr * kNr>(i, n, alpha, a, x, incx, beta, y, incy);
+    }
+    for (; i + kNr <= end; i += kNr) {
+      GemvStrip<kNr>(i, n, alpha, a, x, incx, beta, y, incy);
+    }
+    for (; i < end; ++i) {
+      GemvStrip<1>(i, n, alpha, a, x, incx, beta, y, incy);
+    }
+  } else {
+    for (; i < end; ++i) {
+      Accumulator sum{0};
+      for (int p = 0; p < n; ++p) {
+        sum += static_cast<Accumulator>(a.At(i, p)) * x[p * incx];
+      }
+      y[i * incy] = GemvResult(sum, alpha, beta, y[i * incy]);
+    }
+  }
+}
+
+/**
+ * @brief Округляет value вверх до кратного step.
+ */
+int RoundUp(int value, int step) { return (value + step - 1) / step * step; }
+
+}  // namespace
+
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, ConstMatrixRef<T> a,
+          ConstMatrixRef<T> b, T beta, T* c, std::ptrdiff_t ldc) {
+  if (m <= 0 || n <= 0) {
+    return;
+  }
+
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  const int threads = pool.GetNumThreads();
+  if (threads == 1 ||
+      static_cast<long long>(m) * n * k < kGemmParallelVolume) {
+    GemmSerial(m, n, k, alpha, a, b, beta, c, ldc);
+    return;
+  }
+
+  // C делится на двумерные тайлы примерно одинаковой площади, по
+  // kGemmTilesPerThread на поток, чтобы сгладить неравномерность нагрузки
+  const long long tiles_wanted =
+      static_cast<long long>(threads) * kGemmTilesPerThread;
+  const int side = std::max(
+      kGemmMinTile,
+      static_cast<int>(std::sqrt(static_cast<double>(m) * n / tiles_wanted)));
+  const int tile_m = std::min(m, RoundUp(side, kGemmMr));
+  const int tile_n = std::min(n, RoundUp(side, GemmTraits<T>::kNr));
+  const int tiles_m = (m + tile_m - 1) / tile_m;
+  const int tiles_n = (n + tile_n - 1) / tile_n;
+
+  pool.ParallelFor(tiles_m * tiles_n, [&](int tile) {
+    const int i0 = (tile / tiles_n) * tile_m;
+    const int j0 = (tile % tiles_n) * tile_n;
+    const ConstMatrixRef<T> a_block = {a.data + i0 * a.row_stride,
+                                       a.row_stride, a.col_stride};
+    const ConstMatrixRef<T> b_block = {b.data + j0 * b.col_stride,
+                                       b.row_stride, b.col_stride};
+    GemmSerial(std::min(tile_m, m - i0), std::min(tile_n, n - j0), k, alpha,
+               a_block, b_block, beta, c + i0 * ldc + j0, ldc);
+  });
+}
+
+template <typename T>
+void Gemv(int m, int n, T alpha, ConstMatrixRef<T> a, const T* x,
+          std::ptrdiff_t incx, T beta, T* y, std::ptrdiff_t incy) {
+  if (m <= 0) {
+    return;
+  }
+
+  // полосы кратны полосе GemvStrip, поэтому потоки не пишут в одну
+  // строку кэша y
+  S21ThreadPool::Instance().ParallelForRanges(
+      m, static_cast<long long>(m) * n, kGemvParallelSize,
+      kGemmMr * GemmTraits<T>::kNr, [&](int begin, int end) {
+        GemvRange(begin, end, n, alpha, a, x, incx, beta, y, incy);
+      });
+}
+
+#define S21_INSTANTIATE_GEMM(T)                                    \
+  template void Gemm<T>(int, int, int, T, ConstMatrixRef<T>,       \
+                        ConstMatrixRef<T>, T, T*, std::ptrdiff_t); \
+  template void Gemv<T>(int, int, T, ConstMatrixRef<T>, const T*,  \
+                        std::ptrdiff_t, T, T*, std::ptrdiff_t);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_GEMM)
+#undef S21_INSTANTIATE_GEMM
+
+}  // namespace s21::kernels
@@ -0,0 +1,429 @@
+/**
+ * @file matrix_io.cpp
+ * @brief Двоичное сохранение и загрузка матриц с отображением файла в
+ * память.
+ *
+ * Формат файла описан в s21_matrix_file.h: заголовок и буфер матрицы
+ * rows x stride как есть, со смещения, кратного 64. Поэтому при загрузке
+ * файл можно отобразить в память и использовать его страницы как буфер
+ * матрицы без чтения и копирования: страницы подгружаются системой при
+ * первом обращении.
+ *
+ * Заголовок отображённого файла в памяти процесса (MAP_PRIVATE)
+ * заменяется заголовком блока S21BasicMatrix, указывающим на MappedFile,
+ * так что матрица освобождает отображение так же, как обычный буфер.
+ * Отображение только для чтения (LoadView) заголовок не меняет: им владеет
+ * представление через shared_ptr.
+ */
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_file.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+
+namespace s21::file {
+
+namespace {
+
+constexpr std::uint64_t kBasis = 0xcbf29ce484222325ULL;
+constexpr std::uint64_t kPrime = 0x100000001b3ULL;
+
+}  // namespace
+
+void Checksum::Block(const unsigned char* block) {
+  for (int lane = 0; lane < 4; ++lane) {
+    std::uint64_t word;
+    std::memcpy(&word, block + 8 * lane, sizeof(word));
+    lanes_[lane] = (lanes_[lane] ^ word) * kPrime;
+    lanes_[lane] ^= lanes_[lane] >> 29;
+  }
+}
+
+void Checksum::Update(const void* data, std::size_t bytes) {
+  const unsigned char* src = static_cast<const unsigned char*>(data);
+  total_ += bytes;
+  if (tail_size_ > 0) {
+    const std::size_t take = std::min(bytes, kBlock - tail_size_);
+    std::memcpy(tail_ + tail_size_, src, take);
+    tail_size_ += take;
+    src += take;
+    bytes -= take;
+    if (tail_size_ < kBlock) {
+      return;
+    }
+    Block(tail_);
+    tail_size_ = 0;
+  }
+  for (; bytes >= kBlock; src += kBlock, bytes -= kBlock) {
+    Block(src);
+  }
+  std::memcpy(tail_, src, bytes);
+  tail_size_ = bytes;
+}
+
+std::uint64_t Checksum::Digest() const {
+  std::uint64_t hash = kBasis ^ total_;
+  for (std::uint64_t lane : lanes_) {
+    hash = (hash ^ lane) * kPrime;
+  }
+  // хвост короче 32 байт добавляется побайтно
+  for (std::size_t i = 0; i < tail_size_; ++i) {
+    hash = (hash ^ tail_[i]) * kPrime;
+  }
+  return hash;
+}
+
+std::uint64_t Checksum::Of(const void* data, std::size_t bytes) {
+  Checksum checksum;
+  checksum.Update(data, bytes);
+  return checksum.Digest();
+}
+
+Header MakeHeader(std::uint32_t element_type, std::size_t element_size,
+                  int rows, int cols, int stride) {
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.byte_order = kByteOrderMark;
+  header.element_type = element_type;
+  header.rows = rows;
+  header.cols = cols;
+  header.stride = stride;
+  header.data_offset = kDataOffset;
+  header.payload_bytes = element_size * static_cast<std::uint64_t>(rows) *
+                         static_cast<std::uint64_t>(stride);
+  return header;
+}
+
+std::uint64_t HeaderChecksum(const Header& header) {
+  return Checksum::Of(&header, offsetof(Header, header_checksum));
+}
+
+Descriptor::~Descriptor() {
+  if (fd_ >= 0) {
+    ::close(fd_);
+  }
+}
+
+int OpenForReading(const std::string& path, std::uint64_t& file_size) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  struct stat info;
+  if (fd < 0 || ::fstat(fd, &info) != 0) {
+    if (fd >= 0) {
+      ::close(fd);
+    }
+    throw std::runtime_error("Cannot open matrix file: " + path);
+  }
+  file_size = static_cast<std::uint64_t>(info.st_size);
+  return fd;
+}
+
+Header ReadHeader(int fd, const std::string& path, std::uint64_t file_size,
+                  std::uint32_t element_type, std::size_t element_size) {
+  Header header;
+  if (!ReadAt(fd, &header, sizeof(header), 0) ||
+      std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.header_checksum != HeaderChecksum(header)) {
+    ThrowCorrupted(path);
+  }
+  if (header.version != kVersion || header.byte_order != kByteOrderMark) {
+    throw std::runtime_error("Unsupported matrix file format: " + path);
+  }
+  if (header.element_type != element_type) {
+    throw std::runtime_error(
+        "Matrix file element type does not match the matrix: " + path);
+  }
+  // rows * stride < 2^62 не переполняется, а умножение на размер элемента
+  // может: тогда payload_bytes совпал бы с усечённым произведением
+  const std::uint64_t elements = static_cast<std::uint64_t>(header.rows) *
+                                 static_cast<std::uint64_t>(header.stride);
+  if (header.rows < 0 || header.cols < 0 || header.stride < header.cols ||
+      elements > std::numeric_limits<std::uint64_t>::max() / element_size ||
+      header.payload_bytes != element_size * elements ||
+      header.data_offset < sizeof(header) ||
+      header.data_offset % kDataOffset != 0 ||
+      header.data_offset > file_size ||
+      header.payload_bytes > file_size - header.data_offset) {
+    ThrowCorrupted(path);
+  }
+  return header;
+}
+
+/**
+ * @brief Читает bytes байт со смещения offset, повторяя короткие чтения.
+ *
+ * @return false, если файл закончился раньше или чтение не удалось.
+ */
+bool ReadAt(int fd, void* data, std::size_t bytes, std::uint64_t offset) {
+  // одно чтение ограничено 1 ГБ: больше не принимают некоторые системы
+  constexpr std::size_t kMaxChunk = std::size_t{1} << 30;
+  char* dst = static_cast<char*>(data);
+  while (bytes > 0) {
+    const std::size_t chunk = std::min(bytes, kMaxChunk);
+    const ssize_t got = ::pread(fd, dst, chunk, static_cast<off_t>(offset));
+    if (got <= 0) {
+      return false;
+    }
+    dst += got;
+    offset += static_cast<std::uint64_t>(got);
+    bytes -= static_cast<std::size_t>(got);
+  }
+  return true;
+}
+
+/**
+ * @brief Записывает bytes байт со смещения offset, повторяя короткие
+ * записи.
+ */
+bool WriteAt(int fd, const void* data, std::size_t bytes,
+             std::uint64_t offset) {
+  constexpr std::size_t kMaxChunk = std::size_t{1} << 30;
+  const char* src = static_cast<const char*>(data);
+  while (bytes > 0) {
+    const std::size_t chunk = std::min(bytes, kMaxChunk);
+    const ssize_t put = ::pwrite(fd, src, chunk, static_cast<off_t>(offset));
+    if (put <= 0) {
+      return false;
+    }
+    src += put;
+    offset += static_cast<std::uint64_t>(put);
+    bytes -= static_cast<std::size_t>(put);
+  }
+  return true;
+}
+
+void ThrowCorrupted(const std::string& path) {
+  throw std::runtime_error("Matrix file is corrupted: " + path);
+}
+
+std::string TemporaryPath(const std::string& path) {
+  return path + ".tmp." + std::to_string(::getpid());
+}
+
+}  // namespace s21::file
+
+namespace {
+
+/**
+ * @brief Владелец отображения файла в роли распределителя.
+ *
+ * Стоит в заголовке блока отображённой матрицы: когда матрица освобождает
+ * буфер, Deallocate снимает отображение и удаляет владельца.
+ */
+class MappedFile final : public S21MatrixAllocator {
+ public:
+  MappedFile(void* base, std::size_t length) : base_(base), length_(length) {}
+
+  void* Allocate(std::size_t) override { throw std::bad_alloc(); }
+  void Deallocate(void*, std::size_t) noexcept override {
+    ::munmap(base_, length_);
+    delete this;
+  }
+
+ private:
+  void* base_;
+  std::size_t length_;
+};
+
+}  // namespace
+
+/**
+ * @brief Сохраняет матрицу в двоичный файл.
+ *
+ * Буфер записывается целиком, вместе с выравнивающим заполнением строк,
+ * чтобы Load мог отобразить его в память без перекладки. Существующий
+ * файл заменяется атомарно.
+ *
+ * @param path Путь к файлу.
+ * @throws std::runtime_error Если файл не удалось записать.
+ */
+template <typename T>
+void S21BasicMatrix<T>::Save(const std::string& path) const {
+  namespace file = s21::file;
+  file::Header header = file::MakeHeader(file::ElementType<T>(), sizeof(T),
+                                         rows_, cols_, stride_);
+  header.payload_checksum = file::Checksum::Of(matrix_, header.payload_bytes);
+  header.header_checksum = file::HeaderChecksum(header);
+
+  // запись во временный файл и переименование: файл по пути path всегда
+  // целый, а уже отображённые старые версии остаются у своих матриц
+  const std::string temporary = file::TemporaryPath(path);
+  std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+  out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  if (header.payload_bytes > 0) {
+    out.write(reinterpret_cast<const char*>(matrix_),
+              static_cast<std::streamsize>(header.payload_bytes));
+  }
+  out.close();
+  if (!out || std::rename(temporary.c_str(), path.c_str()) != 0) {
+    std::remove(temporary.c_str());
+    throw std::runtime_error("Cannot write matrix file: " + path);
+  }
+}
+
+/**
+ * @brief Загружает матрицу, сохранённую Save.
+ *
+ * В режиме kCopyOnWrite файл отображается в память и его страницы
+ * становятся буфером матрицы: загрузка не читает данные и занимает время,
+ * не зависящее от размера. Изменения матрицы остаются в памяти процесса и
+ * не попадают в файл; защищённое от записи отображение возвращает
+ * LoadView. Отображённая матрица зависит от файла: его нельзя обрезать или
+ * менять на месте, пока она существует (Save заменяет файл, не затрагивая
+ * её).
+ * Если шаг строки в файле не совпадает с шагом, который эта сборка
+ * выбирает для таких размеров (например, малая матрица, хранимая во
+ * встроенном буфере), данные копируются, как в режиме kCopy.
+ *
+ * @param path Путь к файлу.
+ * @param mode Способ загрузки.
+ * @param verify Сверить контрольную сумму данных; требует прочитать файл
+ * целиком. Заголовок проверяется всегда.
+ * @return Загруженная матрица.
+ * @throws std::runtime_error Если файл не открывается, повреждён или
+ * хранит элементы другого типа.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Load(const std::string& path,
+                                          S21MatrixLoadMode mode,
+                                          bool verify) {
+  namespace file = s21::file;
+  std::uint64_t file_size = 0;
+  const file::Descriptor fd(file::OpenForReading(path, file_size));
+  const file::Header header = file::ReadHeader(
+      fd.Get(), path, file_size, file::ElementType<T>(), sizeof(T));
+  const int rows = header.rows;
+  const int cols = header.cols;
+  const int stride = header.stride;
+
+  S21BasicMatrix result;
+  const bool mappable = !FitsInline(rows, cols) && stride == CalcStride(cols);
+  if (mode == S21MatrixLoadMode::kCopy || !mappable ||
+      header.payload_bytes == 0) {
+    result = S21BasicMatrix(rows, cols);
+    if (result.stride_ == stride) {
+      if (!file::ReadAt(fd.Get(), result.matrix_, header.payload_bytes,
+                        header.data_offset) ||
+          (verify &&
+           file::Checksum::Of(result.matrix_, header.payload_bytes) !=
+               header.payload_checksum)) {
+        file::ThrowCorrupted(path);
+      }
+    } else {
+      // другой шаг строки: данные читаются целиком и перекладываются
+      std::vector<T> payload(static_cast<std::size_t>(rows) * stride);
+      if (!file::ReadAt(fd.Get(), payload.data(), header.payload_bytes,
+                        header.data_offset) ||
+          (verify &&
+           file::Checksum::Of(payload.data(), header.payload_bytes) !=
+               header.payload_checksum)) {
+        file::ThrowCorrupted(path);
+      }
+      for (int i = 0; i < rows; ++i) {
+        std::memcpy(result.row(i),
+                    payload.data() + static_cast<std::size_t>(i) * stride,
+                    sizeof(T) * cols);
+      }
+    }
+    return result;
+  }
+
+  // запись разрешена, чтобы положить заголовок блока: страницы
+  // MAP_PRIVATE копируются только при изменении, файл не меняется
+  const std::size_t length = header.data_offset + header.payload_bytes;
+  void* base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      fd.Get(), 0);
+  if (base == MAP_FAILED) {
+    throw std::runtime_error("Cannot map matrix file: " + path);
+  }
+  char* data = static_cast<char*>(base) + header.data_offset;
+  if (verify && file::Checksum::Of(data, header.payload_bytes) !=
+                    header.payload_checksum) {
+    ::munmap(base, length);
+    file::ThrowCorrupted(path);
+  }
+
+  MappedFile* owner = new (std::nothrow) MappedFile(base, length);
+  if (owner == nullptr) {
+    ::munmap(base, length);
+    throw std::bad_alloc();
+  }
+  ::new (data - kAlignment) BlockHeader{owner, length};
+  result.rows_ = rows;
+  result.cols_ = cols;
+  result.stride_ = stride;
+  result.matrix_ = reinterpret_cast<T*>(data);
+  return result;
+}
+
+/**
+ * @brief Отображает файл, сохранённый Save, только для чтения.
+ *
+ * Возвращается представление, которое владеет отображением: страницы
+ * защищены от записи, а изменить данные через представление нельзя. Блоки
+ * и транспонирования представления совместно владеют отображением, оно
+ * снимается вместе с последним из них; S21Matrix(view) делает изменяемую
+ * копию. Как и в Load, файл нельзя обрезать или менять на месте, пока
+ * отображение существует. Шаг строки и размер матрицы могут быть любыми.
+ *
+ * @param path Путь к файлу.
+ * @param verify Сверить контрольную сумму данных.
+ * @return Представление загруженной матрицы.
+ * @throws std::runtime_error Если файл не открывается, повреждён или
+ * хранит элементы другого типа.
+ */
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::LoadView(const std::string& path,
+                                                  bool verify) {
+  namespace file = s21::file;
+  std::uint64_t file_size = 0;
+  const file::Descriptor fd(file::OpenForReading(path, file_size));
+  const file::Header header = file::ReadHeader(
+      fd.Get(), path, file_size, file::ElementType<T>(), sizeof(T));
+
+  const std::size_t length = header.data_offset + header.payload_bytes;
+  void* base = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd.Get(), 0);
+  if (base == MAP_FAILED) {
+    throw std::runtime_error("Cannot map matrix file: " + path);
+  }
+  // deleter снимает отображение и при исключении в самом shared_ptr
+  const std::shared_ptr<const void> owner(base, [length](const void* ptr) {
+    ::munmap(const_cast<void*>(ptr), length);
+  });
+  const T* data = reinterpret_cast<const T*>(static_cast<const char*>(base) +
+                                             header.data_offset);
+  if (verify && file::Checksum::Of(data, header.payload_bytes) !=
+                    header.payload_checksum) {
+    file::ThrowCorrupted(path);
+  }
+  S21BasicMatrixView<T> view(data, header.rows, header.cols, header.stride);
+  view.owner_ = owner;
+  return view;
+}
+
+#define S21_INSTANTIATE_IO(T)                                      \
+  template void S21BasicMatrix<T>::Save(const std::string&) const; \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::Load(              \
+      const std::string&, S21MatrixLoadMode, bool);                \
+  template S21BasicMatrixView<T> S21BasicMatrix<T>::LoadView(      \
+      const std::string&, bool);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_IO)
+#undef S21_INSTANTIATE_IO
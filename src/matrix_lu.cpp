@@ -0,0 +1,492 @@
+/**
+ * @file matrix_lu.cpp
+ * @brief LU-разложение и основанные на нём обращение матрицы и вычисление
+ * алгебраических дополнений.
+ */
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+/**
+ * @brief Раскладывает квадратную матрицу на месте: P * A = L * U.
+ *
+ * Алгоритм Гаусса с выбором максимального по модулю элемента столбца,
+ * O(n^3) операций. Строки переставляются целиком, исключение идёт по
+ * непрерывным строкам буфера.
+ *
+ * @param a Матрица, на месте которой остаются упакованные L и U.
+ * @param pivots Вектор перестановок (размер n).
+ * @return Знак перестановки P.
+ */
+template <typename T>
+int Factorize(S21BasicMatrix<T>& a, std::vector<int>& pivots) {
+  const int n = a.GetRows();
+  int sign = 1;
+  for (int k = 0; k < n; ++k) {
+    int pivot = k;
+    T pivot_abs = std::fabs(a(k, k));
+    for (int i = k + 1; i < n; ++i) {
+      const T value = std::fabs(a(i, k));
+      if (value > pivot_abs) {
+        pivot = i;
+        pivot_abs = value;
+      }
+    }
+
+    pivots[k] = pivot;
+    if (pivot != k) {
+      std::swap_ranges(a.row(k), a.row(k) + n, a.row(pivot));
+      sign = -sign;
+    }
+    if (pivot_abs == 0.0) {
+      continue;  // столбец уже нулевой, исключать нечего
+    }
+
+    const T* pivot_row = a.row(k);
+    for (int i = k + 1; i < n; ++i) {
+      T* current = a.row(i);
+      const T factor = current[k] / pivot_row[k];
+      current[k] = factor;
+      if (factor == 0.0) {
+        continue;
+      }
+      for (int j = k + 1; j < n; ++j) {
+        current[j] -= factor * pivot_row[j];
+      }
+    }
+  }
+  return sign;
+}
+
+/**
+ * @brief Отношение наименьшего ведущего элемента U к наибольшему.
+ *
+ * Дешёвая оценка обратного числа обусловленности: близкое к нулю значение
+ * означает, что матрица численно вырождена.
+ */
+template <typename T>
+double PivotRatio(const S21BasicMatrix<T>& lu) {
+  const int n = lu.GetRows();
+  if (n == 0) {
+    return 0.0;
+  }
+  T min_pivot = std::fabs(lu(0, 0));
+  T max_pivot = min_pivot;
+  for (int k = 1; k < n; ++k) {
+    const T value = std::fabs(lu(k, k));
+    min_pivot = std::min(min_pivot, value);
+    max_pivot = std::max(max_pivot, value);
+  }
+  return max_pivot == 0.0 ? 0.0 : min_pivot / max_pivot;
+}
+
+/**
+ * @brief Порог PivotRatio, ниже которого матрица n x n считается вырожденной.
+ */
+template <typename T>
+double SingularityThreshold(int n) {
+  return n * std::numeric_limits<T>::epsilon();
+}
+
+/**
+ * @brief Обращает на месте верхнетреугольную часть U.
+ *
+ * Столбцы обрабатываются слева направо: столбец j получается умножением
+ * уже обращённого блока U[0:j, 0:j] на исходный столбец.
+ */
+template <typename T>
+void InvertUpper(S21BasicMatrix<T>& a) {
+  const int n = a.GetRows();
+  for (int j = 0; j < n; ++j) {
+    a(j, j) = T{1} / a(j, j);
+    const T ajj = -a(j, j);
+    for (int i = 0; i < j; ++i) {
+      const T* a_row = a.row(i);
+      T sum = 0.0;
+      for (int k = i; k < j; ++k) {
+        sum += a_row[k] * a(k, j);
+      }
+      a(i, j) = sum * ajj;
+    }
+  }
+}
+
+/**
+ * @brief Решает X * L = U^-1 на месте, L - единичная нижнетреугольная.
+ *
+ * Столбцы обрабатываются справа налево; множители L из текущего столбца
+ * сохраняются в work, а их место обнуляется.
+ */
+template <typename T>
+void SolveUnitLowerRight(S21BasicMatrix<T>& a, std::vector<T>& work) {
+  const int n = a.GetRows();
+  for (int j = n - 2; j >= 0; --j) {
+    for (int i = j + 1; i < n; ++i) {
+      work[i] = a(i, j);
+      a(i, j) = 0.0;
+    }
+    for (int i = 0; i < n; ++i) {
+      T* a_row = a.row(i);
+      T sum = 0.0;
+      for (int k = j + 1; k < n; ++k) {
+        sum += a_row[k] * work[k];
+      }
+      a_row[j] -= sum;
+    }
+  }
+}
+
+/**
+ * @brief Умножает матрицу справа на P: переставляет столбцы в обратном
+ * порядке шагов разложения.
+ */
+template <typename T>
+void ApplyColumnSwaps(S21BasicMatrix<T>& a, const std::vector<int>& pivots) {
+  for (int j = static_cast<int>(pivots.size()) - 1; j >= 0; --j) {
+    const int p = pivots[j];
+    if (p != j) {
+      for (int i = 0; i < a.GetRows(); ++i) {
+        T* a_row = a.row(i);
+        std::swap(a_row[j], a_row[p]);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Умножает матрицу слева на Q: переставляет строки в обратном
+ * порядке шагов разложения.
+ */
+template <typename T>
+void ApplyRowSwaps(S21BasicMatrix<T>& a, const std::vector<int>& pivots) {
+  const int n = a.GetCols();
+  for (int i = static_cast<int>(pivots.size()) - 1; i >= 0; --i) {
+    const int p = pivots[i];
+    if (p != i) {
+      std::swap_ranges(a.row(i), a.row(i) + n, a.row(p));
+    }
+  }
+}
+
+/**
+ * @brief Раскладывает матрицу на месте с полным выбором: P * A * Q = L * U.
+ *
+ * На каждом шаге ведущим становится максимальный по модулю элемент всей
+ * оставшейся подматрицы, поэтому близкие к нулю ведущие элементы
+ * собираются в конце диагонали U (разложение выявляет ранг).
+ *
+ * @return Знак произведения перестановок P и Q.
+ */
+template <typename T>
+int FactorizeFullPivot(S21BasicMatrix<T>& a, std::vector<int>& row_pivots,
+                       std::vector<int>& col_pivots) {
+  const int n = a.GetRows();
+  int sign = 1;
+  for (int k = 0; k < n; ++k) {
+    int pivot_row = k, pivot_col = k;
+    T pivot_abs = -1.0;
+    for (int i = k; i < n; ++i) {
+      const T* a_row = a.row(i);
+      for (int j = k; j < n; ++j) {
+        if (std::fabs(a_row[j]) > pivot_abs) {
+          pivot_abs = std::fabs(a_row[j]);
+          pivot_row = i;
+          pivot_col = j;
+        }
+      }
+    }
+
+    row_pivots[k] = pivot_row;
+    col_pivots[k] = pivot_col;
+    if (pivot_row != k) {
+      std::swap_ranges(a.row(k), a.row(k) + n, a.row(pivot_row));
+      sign = -sign;
+    }
+    if (pivot_col != k) {
+      for (int i = 0; i < n; ++i) {
+        T* a_row = a.row(i);
+        std::swap(a_row[k], a_row[pivot_col]);
+      }
+      sign = -sign;
+    }
+    if (pivot_abs == 0.0) {
+      continue;  // оставшаяся подматрица нулевая
+    }
+
+    const T* k_row = a.row(k);
+    for (int i = k + 1; i < n; ++i) {
+      T* current = a.row(i);
+      const T factor = current[k] / k_row[k];
+      current[k] = factor;
+      for (int j = k + 1; j < n; ++j) {
+        current[j] -= factor * k_row[j];
+      }
+    }
+  }
+  return sign;
+}
+
+/**
+ * @brief Записывает в верхний треугольник adj(U) вместо U.
+ *
+ * Для U = [[U11, u], [0, d]] присоединённая матрица равна
+ * [[d * det(U11) * U11^-1, -det(U11) * U11^-1 * u], [0, det(U11)]]. Формула
+ * не делит на d, поэтому верна и для d = 0. U11 должна быть невырожденной.
+ */
+template <typename T>
+void AdjugateUpper(S21BasicMatrix<T>& a) {
+  const int n = a.GetRows();
+  const int last = n - 1;
+  const T d = a(last, last);
+  T det11 = 1.0;
+  for (int k = 0; k < last; ++k) {
+    det11 *= a(k, k);
+  }
+
+  // U11^-1 на месте, как в InvertUpper, но только для первых n - 1 столбцов
+  for (int j = 0; j < last; ++j) {
+    a(j, j) = T{1} / a(j, j);
+    const T ajj = -a(j, j);
+    for (int i = 0; i < j; ++i) {
+      const T* a_row = a.row(i);
+      T sum = 0.0;
+      for (int k = i; k < j; ++k) {
+        sum += a_row[k] * a(k, j);
+      }
+      a(i, j) = sum * ajj;
+    }
+  }
+  // последний столбец: -det(U11) * U11^-1 * u
+  for (int i = 0; i < last; ++i) {
+    const T* a_row = a.row(i);
+    T sum = 0.0;
+    for (int k = i; k < last; ++k) {
+      sum += a_row[k] * a(k, last);
+    }
+    a(i, last) = -det11 * sum;
+  }
+  const T scale = d * det11;
+  for (int i = 0; i < last; ++i) {
+    T* a_row = a.row(i);
+    for (int j = i; j < last; ++j) {
+      a_row[j] *= scale;
+    }
+  }
+  a(last, last) = det11;
+}
+
+/**
+ * @brief Обращает на месте уже разложенную матрицу: A^-1 = U^-1 * L^-1 * P.
+ */
+template <typename T>
+void InvertFactorized(S21BasicMatrix<T>& a, const std::vector<int>& pivots) {
+  std::vector<T> work(a.GetRows());
+  InvertUpper(a);
+  SolveUnitLowerRight(a, work);
+  ApplyColumnSwaps(a, pivots);
+}
+
+}  // namespace
+
+/**
+ * @brief Раскладывает квадратную матрицу в P * A = L * U.
+ *
+ * Вычисления идут на месте в копии матрицы, так что кроме неё и вектора
+ * перестановок память не выделяется.
+ *
+ * @param matrix Раскладываемая матрица.
+ * @throws std::logic_error Если матрица не является квадратной.
+ */
+template <typename T>
+S21BasicMatrixLU<T>::S21BasicMatrixLU(const S21BasicMatrix<T>& matrix)
+    : lu_(matrix), pivots_(matrix.GetRows()), sign_(1) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("Matrix must be square for LU decomposition");
+  }
+  sign_ = Factorize(lu_, pivots_);
+}
+
+/**
+ * @brief Раскладывает временную матрицу в её же буфере.
+ *
+ * @param matrix Квадратная матрица, буфер которой забирает разложение.
+ * @throws std::logic_error Если матрица не является квадратной.
+ */
+template <typename T>
+S21BasicMatrixLU<T>::S21BasicMatrixLU(S21BasicMatrix<T>&& matrix)
+    : lu_(std::move(matrix)), pivots_(lu_.GetRows()), sign_(1) {
+  if (lu_.GetRows() != lu_.GetCols()) {
+    throw std::logic_error("Matrix must be square for LU decomposition");
+  }
+  sign_ = Factorize(lu_, pivots_);
+}
+
+/**
+ * @brief Возвращает отношение наименьшего ведущего элемента U к наибольшему.
+ *
+ * @return Значение из [0, 1]; 0 означает точно вырожденную матрицу.
+ */
+template <typename T>
+double S21BasicMatrixLU<T>::PivotRatio() const { return ::PivotRatio(lu_); }
+
+/**
+ * @brief Проверяет численную вырожденность по ведущим элементам U.
+ *
+ * @return true, если PivotRatio() не превышает n * epsilon.
+ */
+template <typename T>
+bool S21BasicMatrixLU<T>::IsSingular() const {
+  return PivotRatio() <= SingularityThreshold<T>(GetSize());
+}
+
+/**
+ * @brief Вычисляет определитель как произведение диагонали U со знаком P.
+ *
+ * @return Определитель исходной матрицы.
+ */
+template <typename T>
+double S21BasicMatrixLU<T>::Determinant() const {
+  double result = sign_;
+  for (int k = 0; k < GetSize(); ++k) {
+    result *= lu_(k, k);
+  }
+  return result;
+}
+
+/**
+ * @brief Решает A * X = B по готовому разложению: P * B, затем прямая
+ * подстановка с L и обратная с U, O(n^2) операций на правую часть.
+ *
+ * @param b Правые части (n x nrhs).
+ * @return Решение X (n x nrhs).
+ * @throws std::invalid_argument Если число строк b не равно размеру A.
+ * @throws std::logic_error Если матрица вырождена (IsSingular).
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixLU<T>::Solve(
+    const S21BasicMatrix<T>& b) const {
+  const int n = GetSize();
+  if (b.GetRows() != n) {
+    throw std::invalid_argument(
+        "Number of rows in the right-hand side must be equal to the size of "
+        "the matrix");
+  }
+  if (IsSingular()) {
+    throw std::logic_error("Matrix is singular, the system cannot be solved");
+  }
+
+  S21BasicMatrix<T> x(b);
+  const int nrhs = x.GetCols();
+  for (int k = 0; k < n; ++k) {
+    if (pivots_[k] != k) {
+      std::swap_ranges(x.row(k), x.row(k) + nrhs, x.row(pivots_[k]));
+    }
+  }
+  const s21::kernels::ConstMatrixRef<T> lu = {lu_.data(), lu_.GetStride(), 1};
+  s21::kernels::SolveLower<T>(n, nrhs, lu, true, x.data(), x.GetStride());
+  s21::kernels::SolveUpper<T>(n, nrhs, lu, false, x.data(), x.GetStride());
+  return x;
+}
+
+/**
+ * @brief Обращает матрицу на месте.
+ *
+ * LU-разложение записывается поверх матрицы, затем обращается U, решается
+ * X * L = U^-1 и переставляются столбцы согласно P. Кроме вектора
+ * перестановок и одного рабочего столбца память не выделяется. Если
+ * матрица оказалась вырожденной, её содержимое после исключения не
+ * определено.
+ *
+ * @throws std::logic_error Если матрица не квадратная или вырождена, а
+ * также для целых матриц: обратная к ним в общем случае не целая.
+ */
+template <typename T>
+void S21BasicMatrix<T>::InverseMatrixInPlace() {
+  if constexpr (std::is_integral_v<T>) {
+    throw std::logic_error(
+        "Matrix inverse requires a floating-point element type");
+  } else {
+    if (rows_ != cols_) {
+      throw std::logic_error("Matrix must be square to calculate its inverse");
+    }
+
+    std::vector<int> pivots(rows_);
+    Factorize(*this, pivots);
+    if (::PivotRatio(*this) <= SingularityThreshold<T>(rows_)) {
+      throw std::logic_error(
+          "Matrix is singular, its inverse cannot be calculated");
+    }
+
+    InvertFactorized(*this, pivots);
+  }
+}
+
+/**
+ * @brief Вычисляет матрицу алгебраических дополнений из одного разложения.
+ *
+ * Для невырожденной матрицы дополнения равны det(A) * A^-T. Для вырожденной
+ * и почти вырожденной используется разложение с полным выбором
+ * P * A * Q = L * U: adj(A) = det(P) * det(Q) * Q * adj(U) * L^-1 * P, где
+ * adj(U) выражается без деления на последний (почти нулевой) ведущий
+ * элемент. Если ранг меньше n - 1, все дополнения равны нулю. Всё вместе
+ * занимает O(n^3) операций.
+ *
+ * @return Матрица алгебраических дополнений.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::ComplementsByFactorization() const {
+  S21BasicMatrix work(*this);
+  std::vector<int> pivots(rows_);
+  const int sign = Factorize(work, pivots);
+
+  if (::PivotRatio(work) > SingularityThreshold<T>(rows_)) {
+    double determinant = sign;
+    for (int k = 0; k < rows_; ++k) {
+      determinant *= work(k, k);
+    }
+    InvertFactorized(work, pivots);
+    S21BasicMatrix result = work.Transpose();
+    result.MulNumber(determinant);
+    return result;
+  }
+
+  work = *this;
+  std::vector<int> col_pivots(rows_);
+  const int full_sign = FactorizeFullPivot(work, pivots, col_pivots);
+
+  // при полном выборе ведущие элементы не возрастают; если вырожден уже
+  // блок U11, ранг не больше n - 2 и все дополнения нулевые
+  const double tolerance =
+      SingularityThreshold<T>(rows_) * std::fabs(work(0, 0));
+  if (std::fabs(work(rows_ - 2, rows_ - 2)) <= tolerance) {
+    return S21BasicMatrix(rows_, cols_);
+  }
+
+  std::vector<T> column(rows_);
+  AdjugateUpper(work);
+  SolveUnitLowerRight(work, column);
+  ApplyColumnSwaps(work, pivots);
+  ApplyRowSwaps(work, col_pivots);
+  work.MulNumber(full_sign);
+  return work.Transpose();
+}
+
+#define S21_INSTANTIATE_FLOATING(T)                                          \
+  template class S21BasicMatrixLU<T>;                                        \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::ComplementsByFactorization() \
+      const;
+S21_MATRIX_FOR_EACH_FLOATING_TYPE(S21_INSTANTIATE_FLOATING)
+#undef S21_INSTANTIATE_FLOATING
+
+#define S21_INSTANTIATE_INVERSE(T) \
+  template void S21BasicMatrix<T>::InverseMatrixInPlace();
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_INVERSE)
+#undef S21_INSTANTIATE_INVERSE
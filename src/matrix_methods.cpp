@@ -1,9 +1,16 @@
 /**
  * @file matrix_methods.cpp
- * @brief Реализация операций с матрицами для класса S21.
+ * @brief Реализация операций с матрицами для шаблона S21BasicMatrix.
  */
 
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_kernels.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_stats.h"
 
 /**
  * @brief Добавляет вторую матрицу к текущей.
@@ -11,17 +18,16 @@
  * @param other Матрица, которая будет добавлена к текущей матрице.
  * @throws std::invalid_argument Если размеры матриц не совпадают.
  */
-void S21Matrix::SumMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.GetRows() || cols_ != other.GetCols()) {
     throw std::invalid_argument(
         "Matrices must have the same dimensions for addition");
   }
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kSumMatrix, Elements(),
+                         3 * sizeof(T) * Elements());
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] += other(i, j);
-    }
-  }
+  s21::kernels::Add(matrix_, other.matrix_, BufferSize());
 }
 
 /**
@@ -30,56 +36,77 @@ void S21Matrix::SumMatrix(const S21Matrix& other) {
  * @param other Матрица, которая будет вычтена из текущей матрицы.
  * @throws std::invalid_argument Если размеры матриц не совпадают.
  */
-void S21Matrix::SubMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.GetRows() || cols_ != other.GetCols()) {
     throw std::invalid_argument(
         "Matrices must have the same dimensions for subtraction");
   }
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kSubMatrix, Elements(),
+                         3 * sizeof(T) * Elements());
 
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] -= other(i, j);
-    }
-  }
+  s21::kernels::Sub(matrix_, other.matrix_, BufferSize());
 }
 
 /**
  * @brief Умножает текущую матрицу на другую матрицу.
  *
+ * Произведение пишется в новую матрицу тем же путём, что и Gemm с
+ * beta = 0 (MultiplyInto), и переносится в *this без копирования.
+ *
  * @param other Матрица, на которую будет умножена текущая матрица.
+ * @param algorithm Алгоритм умножения (см. S21MatrixMulAlgorithm).
  * @throws std::invalid_argument Если число столбцов первой матрицы не равно
  * числу строк второй матрицы.
  */
-void S21Matrix::MulMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other,
+                                  S21MatrixMulAlgorithm algorithm) {
   if (cols_ != other.GetRows()) {
     throw std::invalid_argument(
         "Number of columns in the first matrix must be equal to the number of "
         "rows in the second matrix for multiplication");
   }
 
-  S21Matrix result(rows_, other.GetCols());
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < other.GetCols(); ++j) {
-      for (int k = 0; k < other.rows_; ++k) {
-        result(i, j) += matrix_[i][k] * other(k, j);
-      }
-    }
-  }
+  *this = Multiply(*this, other, algorithm);
+}
 
-  *this = result;
+/**
+ * @brief Вычисляет произведение двух матриц в новую матрицу.
+ *
+ * Размеры должны быть проверены вызывающим методом.
+ *
+ * @param a Левый множитель.
+ * @param b Правый множитель.
+ * @param algorithm Алгоритм умножения.
+ * @return Произведение a * b.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Multiply(const S21BasicMatrix& a,
+                                              const S21BasicMatrix& b,
+                                              S21MatrixMulAlgorithm algorithm) {
+  S21_MATRIX_STATS_SCOPE(
+      S21MatrixOp::kMulMatrix, 2 * a.Elements() * b.cols_,
+      sizeof(T) * (a.Elements() + b.Elements() +
+                   static_cast<unsigned long long>(a.rows_) * b.cols_));
+  S21BasicMatrix result(a.rows_, b.cols_);
+  MultiplyInto(T{1}, a, S21MatrixTranspose::kNone, b,
+               S21MatrixTranspose::kNone, T{0}, result, algorithm);
+  return result;
 }
 
 /**
  * @brief Умножает текущую матрицу на число
  *
+ * Элементы целых матриц умножаются в double, дробная часть отбрасывается.
+ *
  * @param num зЗначение, на которое будет умножена матрица.
  */
-void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      matrix_[i][j] *= num;
-    }
-  }
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const double num) {
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kMulNumber, Elements(),
+                         2 * sizeof(T) * Elements());
+  s21::kernels::Scale(matrix_, num, BufferSize());
 }
 
 /**
@@ -89,51 +116,105 @@ void S21Matrix::MulNumber(const double num) {
  * @param rows Новое количество строк.
  * @param cols Новое количество столбцов.
  */
-void S21Matrix::Resize(int rows, int cols) {
-  matrix_.resize(rows);
-  for (int i = 0; i < rows; ++i) {
-    matrix_[i].resize(cols);
+template <typename T>
+void S21BasicMatrix<T>::Resize(int rows, int cols) {
+  if (rows == rows_ && cols == cols_) {
+    return;
+  }
+
+  S21BasicMatrix resized(rows, cols);
+  const int keep_rows = std::min(rows, rows_);
+  const int keep_cols = std::min(cols, cols_);
+  for (int i = 0; i < keep_rows; ++i) {
+    std::memcpy(resized.row(i), row(i), sizeof(T) * keep_cols);
   }
-  rows_ = rows;
-  cols_ = cols;
+
+  *this = std::move(resized);
 }
 
 /**
  * @brief Создает и возвращает транспонированную матрицу.
  *
+ * Используется кэш-независимое блочное транспонирование
+ * s21::kernels::Transpose.
+ *
  * @return Транспонированная матрица.
  */
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix transposed(cols_, rows_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      transposed(j, i) = matrix_[i][j];
-    }
-  }
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const {
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kTranspose, 0,
+                         2 * sizeof(T) * Elements());
+  S21BasicMatrix transposed(cols_, rows_);
+  s21::kernels::Transpose(matrix_, stride_, transposed.matrix_,
+                          transposed.stride_, rows_, cols_);
   return transposed;
 }
 
+/**
+ * @brief Транспонирует квадратную матрицу на месте без выделения памяти.
+ *
+ * @throws std::logic_error Если матрица не является квадратной.
+ */
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  if (rows_ != cols_) {
+    throw std::logic_error("Matrix must be square to transpose it in place");
+  }
+  s21::kernels::TransposeSquareInPlace(matrix_, stride_, rows_);
+}
+
 /**
  * @brief Вычисляет и возвращает матрицу алгебраических дополнений текущей
  * матрицы.
  *
+ * До 3x3 миноры считаются явно, для больших вещественных матриц
+ * дополнения выводятся из одного разложения за O(n^3), см.
+ * ComplementsByFactorization. Для целых матриц каждый минор вычисляется
+ * точно алгоритмом Барейса без деления с остатком, O(n^5).
+ *
  * @return Матрица алгебраических дополнений.
  * @throws std::logic_error Если матрица не является квадратной.
  */
-S21Matrix S21Matrix::CalcComplements() {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const {
   if (rows_ != cols_) {
     // Бросаем исключение, если матрица не квадратная
     throw std::logic_error("Matrix must be square to calculate complements");
   }
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kCalcComplements,
+                         2 * Elements() * rows_, 2 * sizeof(T) * Elements());
+
+  if (rows_ > 3) {
+    if constexpr (std::is_floating_point_v<T>) {
+      return ComplementsByFactorization();
+    } else {
+      S21BasicMatrix result(rows_, cols_);
+      for (int x = 0; x < rows_; ++x) {
+        for (int y = 0; y < cols_; ++y) {
+          const double minor = MinorView(x, y).Determinant();
+          result(x, y) = static_cast<T>((x + y) % 2 == 0 ? minor : -minor);
+        }
+      }
+      return result;
+    }
+  }
 
-  S21Matrix result(rows_, cols_);
+  S21BasicMatrix result(rows_, cols_);
 
   if (rows_ != 1) {
-    S21Matrix aux(rows_, cols_);
+    // миноры порядка 1 и 2 считаются явно, без выделения памяти
+    const S21BasicMatrix& m = *this;
     for (int x = 0; x < rows_; ++x) {
       for (int y = 0; y < cols_; ++y) {
-        S21Matrix minor = GetMatrixMinor(x, y);
-        double minorDeterminant = minor.Determinant();
+        int r[2] = {0, 0}, c[2] = {0, 0};
+        for (int i = 0, ri = 0, ci = 0; i < rows_; ++i) {
+          if (i != x) r[ri++] = i;
+          if (i != y) c[ci++] = i;
+        }
+        T minorDeterminant =
+            (rows_ == 2) ? m(r[0], c[0])
+                         : m(r[0], c[0]) * m(r[1], c[1]) -
+                               m(r[0], c[1]) * m(r[1], c[0]);
         int sign = ((x + y) % 2 == 0) ? 1 : -1;
         result(x, y) = sign * minorDeterminant;
       }
@@ -149,29 +230,27 @@ S21Matrix S21Matrix::CalcComplements() {
 /**
  * @brief Вычисляет и возвращает определитель текущей матрицы.
  *
+ * Матрицы до 3x3 считаются по явной формуле, большие вещественные - через
+ * LU-разложение за O(n^3), большие целые - точно, алгоритмом Барейса.
+ *
  * @return Определитель матрицы.
  * @throws std::logic_error Если матрица не является квадратной.
  */
-double S21Matrix::Determinant() {
+template <typename T>
+double S21BasicMatrix<T>::Determinant() const {
   if (rows_ != cols_) {
     throw std::logic_error(
         "Matrix must be square to calculate its determinant");
   }
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kDeterminant, 2 * Elements() * rows_ / 3,
+                         sizeof(T) * Elements());
 
-  if (rows_ == 1) {
-    return matrix_[0][0];
-  }
-
-  double determinantValue = 0.0;
-
-  for (int j = 0; j < cols_; ++j) {
-    S21Matrix minor = GetMatrixMinor(0, j);
-    double minorDeterminant = minor.Determinant();
-    int sign = (j % 2 == 0) ? 1 : -1;
-    determinantValue += sign * matrix_[0][j] * minorDeterminant;
+  if constexpr (std::is_floating_point_v<T>) {
+    if (rows_ > 3) {
+      return LU().Determinant();
+    }
   }
-
-  return determinantValue;
+  return S21BasicMatrixView<T>(*this).Determinant();
 }
 
 /**
@@ -181,60 +260,31 @@ double S21Matrix::Determinant() {
  * @param col Индекс столбца элемента.
  * @return Минор для указанного элемента.
  */
-S21Matrix S21Matrix::GetMatrixMinor(int row, int col) const {
-  int size = rows_ - 1;
-  S21Matrix minor(size, size);
-
-  int minorRow = 0;
-  for (int i = 0; i < rows_; ++i) {
-    if (i == row) {
-      continue;  // Пропускаем текущую строку, чтобы исключить ее из минора
-    }
-
-    int minorCol = 0;
-    for (int j = 0; j < cols_; ++j) {
-      if (j == col) {
-        continue;  // Пропускаем текущий столбец, чтобы исключить его из минора
-      }
-
-      minor(minorRow, minorCol) =
-          matrix_[i][j];  // Копируем элемент в минорную матрицу
-      minorCol++;
-    }
-
-    minorRow++;
-  }
-
-  return minor;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::GetMatrixMinor(int row, int col) const {
+  S21_MATRIX_STATS_SCOPE(
+      S21MatrixOp::kGetMatrixMinor, 0,
+      2 * sizeof(T) * std::max(rows_ - 1, 0) * std::max(cols_ - 1, 0));
+  return S21BasicMatrix(MinorView(row, col));
 }
 
 /**
  * @brief Вычисляет и возвращает обратную матрицу.
  *
+ * Обращение выполняется через LU-разложение с частичным выбором ведущего
+ * элемента за O(n^3), см. InverseMatrixInPlace.
+ *
  * @return Обратная матрица.
- * @throws std::logic_error Если определитель матрицы равен нулю, что делает
- * вычисление обратной матрицы невозможным.
+ * @throws std::logic_error Если матрица не квадратная или вырождена (ведущие
+ * элементы LU-разложения указывают на численную вырожденность), а также
+ * для целых матриц.
  */
-S21Matrix S21Matrix::InverseMatrix() {
-  if (rows_ != cols_) {
-    throw std::logic_error("Matrix must be square to calculate its inverse");
-  }
-
-  double determinant = Determinant();
-  if (fabs(determinant) < 1e-6) {
-    throw std::logic_error(
-        "Matrix is singular, its inverse cannot be calculated");
-  }
-
-  S21Matrix complements = CalcComplements().Transpose();
-  S21Matrix inverse(rows_, cols_);
-
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      inverse(i, j) = complements(i, j) / determinant;
-    }
-  }
-
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() const {
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kInverseMatrix, 2 * Elements() * rows_,
+                         2 * sizeof(T) * Elements());
+  S21BasicMatrix inverse(*this);
+  inverse.InverseMatrixInPlace();
   return inverse;
 }
 
@@ -243,11 +293,44 @@ S21Matrix S21Matrix::InverseMatrix() {
  *
  * @return Количество строк.
  */
-int S21Matrix::GetRows() const { return rows_; }
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const { return rows_; }
 
 /**
  * @brief Возвращает количество столбцов в матрице.
  *
  * @return Количество столбцов.
  */
-int S21Matrix::GetCols() const { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const { return cols_; }
+
+/**
+ * @brief Возвращает шаг строки во внутреннем буфере.
+ *
+ * @return Расстояние в элементах между началами соседних строк.
+ */
+template <typename T>
+int S21BasicMatrix<T>::GetStride() const { return stride_; }
+
+#define S21_INSTANTIATE_METHODS(T)                                       \
+  template void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix<T>&);  \
+  template void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix<T>&);  \
+  template void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix<T>&,   \
+                                             S21MatrixMulAlgorithm);     \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::Multiply(                \
+      const S21BasicMatrix<T>&, const S21BasicMatrix<T>&,                \
+      S21MatrixMulAlgorithm);                                            \
+  template void S21BasicMatrix<T>::MulNumber(const double);              \
+  template void S21BasicMatrix<T>::Resize(int, int);                     \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() const;       \
+  template void S21BasicMatrix<T>::TransposeInPlace();                   \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() const; \
+  template double S21BasicMatrix<T>::Determinant() const;                \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::GetMatrixMinor(int, int) \
+      const;                                                             \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() const;   \
+  template int S21BasicMatrix<T>::GetRows() const;                       \
+  template int S21BasicMatrix<T>::GetCols() const;                       \
+  template int S21BasicMatrix<T>::GetStride() const;
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_METHODS)
+#undef S21_INSTANTIATE_METHODS
@@ -1,9 +1,14 @@
 /**
  * @file matrix_operators.cpp
- * @brief Реализация перегруженных операторов для класса S21 Matrix
+ * @brief Реализация перегруженных операторов для шаблона S21BasicMatrix
  */
 
+#include <cstring>
+#include <utility>
+
+#include "s21_matrix_kernels.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_stats.h"
 
 /**
  * @brief Перегруженный оператор присваивания
@@ -11,57 +16,60 @@
  * @param other Матрица, которая будет присвоена текущей матрице
  * @return Текущая матрица с новыми значениями
  */
-S21Matrix& S21Matrix::operator=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& other) {
   if (this == &other) {
     return *this;
   }
-
+  S21_MATRIX_STATS_SCOPE(S21MatrixOp::kCopyAssignment, 0,
+                         2 * sizeof(T) * other.Elements());
+
+  if (rows_ != other.rows_ || stride_ != other.stride_) {
+    S21BasicMatrix copy(other);
+    Release();
+    Steal(copy);
+  } else if (matrix_ != nullptr) {
+    // размеры буферов совпадают, переиспользуем текущий
+    std::memcpy(matrix_, other.matrix_, sizeof(T) * BufferSize());
+  }
   rows_ = other.rows_;
   cols_ = other.cols_;
-  matrix_ = std::vector<std::vector<double>>(other.matrix_);
 
   return *this;
 }
 
 /**
- * @brief Перегруженный оператор сложения
+ * @brief Перегруженный оператор присваивания переносом
  *
- * @param other Матрица, которая будет добавлена к текущей матрице
- * @return Результат операции сложения
- * @throws std::invalid_argument Если размеры матриц не совпадают
+ * Забирает буфер other (встроенный - копирует), освобождая текущий;
+ * other становится пустой.
+ *
+ * @param other Матрица, содержимое которой переносится
+ * @return Текущая матрица с новыми значениями
  */
-S21Matrix S21Matrix::operator+(const S21Matrix& other) {
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    throw std::invalid_argument(
-        "Matrices must have the same dimensions for addition");
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(
+    S21BasicMatrix&& other) noexcept {
+  if (this == &other) {
+    return *this;
   }
 
-  S21Matrix result(rows_, cols_);
-  for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      result(i, j) = matrix_[i][j] + other(i, j);
-    }
-  }
+  Release();
+  Steal(other);
 
-  return result;
+  return *this;
 }
 
 /**
- * @brief Перегруженный оператор вычитания
+ * @brief Записывает в матрицу сумму a + b векторизованным ядром
  *
- * @param other Матрица, которая будет вычтена из текущей матрицы
- * @return Результат операции вычитания
- * @throws std::invalid_argument Если размеры матриц не совпадают
+ * Частный случай вычисления выражения: размеры a, b и *this совпадают,
+ * поэтому совпадают и шаги строк, и буферы складываются целиком.
  */
-S21Matrix S21Matrix::operator-(const S21Matrix& other) {
-  if (rows_ != other.rows_ || cols_ != other.cols_) {
-    throw std::invalid_argument(
-        "Matrices must have the same dimensions for addition");
-  }
-  S21Matrix result(rows_, cols_);
-  result = *this;
-  result.SubMatrix(other);
-  return result;
+template <typename T>
+void S21BasicMatrix<T>::EvaluateSum(const S21BasicMatrix& a,
+                                    const S21BasicMatrix& b) {
+  s21::kernels::AddTo(matrix_, a.matrix_, b.matrix_, BufferSize());
 }
 
 /**
@@ -71,10 +79,51 @@ S21Matrix S21Matrix::operator-(const S21Matrix& other) {
  * @return Результат операции умножения
  * @throws std::invalid_argument Если размеры матриц не совместимы для умножения
  */
-S21Matrix S21Matrix::operator*(const S21Matrix& other) {
-  S21Matrix result = *this;
-  result.MulMatrix(other);
-  return result;
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::operator*(
+    const S21BasicMatrix& other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix for multiplication");
+  }
+  return Multiply(*this, other);
+}
+
+/**
+ * @brief Сложение двух временных матриц в буфере левой
+ *
+ * @throws std::invalid_argument Если размеры матриц не совпадают
+ */
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs, S21BasicMatrix<T>&& rhs) {
+  lhs += rhs;
+  return std::move(lhs);
+}
+
+/**
+ * @brief Вычитание двух временных матриц в буфере левой
+ *
+ * @throws std::invalid_argument Если размеры матриц не совпадают
+ */
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs, S21BasicMatrix<T>&& rhs) {
+  lhs -= rhs;
+  return std::move(lhs);
+}
+
+/**
+ * @brief Умножение временной матрицы на число в её же буфере
+ */
+template <typename T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T>&& matrix, double num) {
+  matrix.MulNumber(num);
+  return std::move(matrix);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(double num, S21BasicMatrix<T>&& matrix) {
+  return std::move(matrix) * num;
 }
 
 /**
@@ -83,16 +132,16 @@ S21Matrix S21Matrix::operator*(const S21Matrix& other) {
  * @param other Матрица, которая будет сравниваться с текущей матрицей
  * @return true, если матрицы равны, false в противном случае
  */
-bool S21Matrix::operator==(const S21Matrix& other) const {
+template <typename T>
+bool S21BasicMatrix<T>::operator==(const S21BasicMatrix& other) const {
   if (this->rows_ != other.GetRows() || this->cols_ != other.GetCols()) {
     return false;
   }
 
+  // построчно: заполнение между строками в сравнении не участвует
   for (int i = 0; i < rows_; ++i) {
-    for (int j = 0; j < cols_; ++j) {
-      if (matrix_[i][j] != other(i, j)) {
-        return false;
-      }
+    if (!s21::kernels::Equal(row(i), other.row(i), cols_)) {
+      return false;
     }
   }
   return true;
@@ -104,7 +153,8 @@ bool S21Matrix::operator==(const S21Matrix& other) const {
  * @param other Матрица, которая будет добавлена к текущей матрице
  * @return Текущая матрица с новыми значениями
  */
-S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& other) {
   SumMatrix(other);
   return *this;
 }
@@ -115,7 +165,8 @@ S21Matrix& S21Matrix::operator+=(const S21Matrix& other) {
  * @param other Матрица, которая будет вычтена из текущей матрицы
  * @return Текущая матрица с новыми значениями
  */
-S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& other) {
   SubMatrix(other);
   return *this;
 }
@@ -126,7 +177,8 @@ S21Matrix& S21Matrix::operator-=(const S21Matrix& other) {
  * @param other Матрица, на которую будет умножена текущая матрица
  * @return Текущая матрица с новыми значениями
  */
-S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& other) {
   MulMatrix(other);
   return *this;
 }
@@ -139,32 +191,34 @@ S21Matrix& S21Matrix::operator*=(const S21Matrix& other) {
  * @return Поток вывода с записанной в него матрицей
  * @note позволяет выводить std::cout << matrix;
  */
-std::ostream& operator<<(std::ostream& os, const S21Matrix& matrix) {
-  for (int i = 0; i < matrix.GetRows(); ++i) {
-    for (int j = 0; j < matrix.GetCols(); ++j) {
-      os << matrix(i, j) << " ";
-    }
-    os << std::endl;
-  }
-  return os;
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const S21BasicMatrix<T>& matrix) {
+  return os << S21BasicMatrixView<T>(matrix);
 }
 
-/**
- * @brief Перегруженный оператор индексации для доступа без константы
- *
- * @param i Индекс строки
- * @param j Индекс столбца
- * @return Ссылка на элемент в указанной строке и столбце
- */
-double& S21Matrix::operator()(int i, int j) { return matrix_[i][j]; }
-
-/**
- * @brief Перегруженный оператор индексации для доступа с константой
- *
- * @param i Индекс строки
- * @param j Индекс столбца
- * @return Константная ссылка на элемент в указанной строке и столбце
- */
-double& S21Matrix::operator()(int i, int j) const {
-  return const_cast<double&>(matrix_[i][j]);
-}
+#define S21_INSTANTIATE_OPERATORS(T)                                      \
+  template S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(               \
+      const S21BasicMatrix<T>&);                                          \
+  template S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(               \
+      S21BasicMatrix<T>&&) noexcept;                                      \
+  template void S21BasicMatrix<T>::EvaluateSum(const S21BasicMatrix<T>&,  \
+                                               const S21BasicMatrix<T>&); \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::operator*(                \
+      const S21BasicMatrix<T>&) const;                                    \
+  template bool S21BasicMatrix<T>::operator==(const S21BasicMatrix<T>&)   \
+      const;                                                              \
+  template S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(              \
+      const S21BasicMatrix<T>&);                                          \
+  template S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(              \
+      const S21BasicMatrix<T>&);                                          \
+  template S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(              \
+      const S21BasicMatrix<T>&);                                          \
+  template S21BasicMatrix<T> operator+(S21BasicMatrix<T>&&,               \
+                                       S21BasicMatrix<T>&&);              \
+  template S21BasicMatrix<T> operator-(S21BasicMatrix<T>&&,               \
+                                       S21BasicMatrix<T>&&);              \
+  template S21BasicMatrix<T> operator*(S21BasicMatrix<T>&&, double);      \
+  template S21BasicMatrix<T> operator*(double, S21BasicMatrix<T>&&);      \
+  template std::ostream& operator<<(std::ostream&, const S21BasicMatrix<T>&);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_OPERATORS)
+#undef S21_INSTANTIATE_OPERATORS
@@ -0,0 +1,457 @@
+/**
+ * @file matrix_out_of_core.cpp
+ * @brief Умножение матриц, хранимых в файлах, с ограниченной памятью.
+ *
+ * Операнды и результат живут в файлах формата Save (s21_matrix_file.h) и
+ * могут не помещаться в память. C делится на тайлы mc x nc, внутреннее
+ * измерение - на панели kc; каждый шаг читает тайл A (mc x kc) и тайл B
+ * (kc x nc) и накапливает их произведение тем же ядром s21::kernels::Gemm,
+ * что и MulMatrix. Пока ядро считает текущий шаг, тайлы следующего шага
+ * читаются в запасные буферы, так что диск и процессор работают
+ * одновременно. Готовый тайл C пишется на своё место в файле результата.
+ */
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_file.h"
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+namespace file = s21::file;
+
+/**
+ * @brief Буфер тайла и номер тайла, который в нём лежит.
+ */
+template <typename T>
+struct Tile {
+  long long key = -1;
+  std::vector<T> data;
+};
+
+/**
+ * @brief Открытый файл-операнд и его заголовок.
+ */
+struct Operand {
+  Operand(const std::string& path, std::uint32_t element_type,
+          std::size_t element_size)
+      : fd(file::OpenForReading(path, size)),
+        header(file::ReadHeader(fd.Get(), path, size, element_type,
+                                element_size)) {}
+
+  std::uint64_t size = 0;
+  file::Descriptor fd;
+  file::Header header;
+};
+
+/**
+ * @brief Читает блок rows x cols с позиции (row, col) плотно в dst.
+ *
+ * Блок во всю ширину файла без заполнения читается одним запросом,
+ * иначе - построчно.
+ */
+template <typename T>
+bool ReadBlock(const Operand& operand, int row, int col, int rows, int cols,
+               T* dst) {
+  const file::Header& header = operand.header;
+  const std::uint64_t offset =
+      header.data_offset +
+      sizeof(T) * (static_cast<std::uint64_t>(row) * header.stride + col);
+  if (cols == header.stride) {
+    return file::ReadAt(operand.fd.Get(), dst,
+                        sizeof(T) * static_cast<std::size_t>(rows) * cols,
+                        offset);
+  }
+  for (int i = 0; i < rows; ++i) {
+    T* dst_row = dst + static_cast<std::size_t>(i) * cols;
+    if (!file::ReadAt(operand.fd.Get(), dst_row, sizeof(T) * cols,
+                      offset + sizeof(T) * static_cast<std::uint64_t>(i) *
+                                   header.stride)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Стороны тайлов под бюджет памяти.
+ *
+ * Одновременно живут по два тайла A (mc x kc) и B (kc x nc) и тайл C
+ * (mc x nc): 2 * mc * kc + 2 * kc * nc + mc * nc элементов. При равных
+ * сторонах это 5 t^2; если внутреннее измерение короче t, освободившаяся
+ * память отдаётся тайлу C.
+ */
+struct TileShape {
+  int mc, nc, kc;
+};
+
+TileShape FitTiles(int m, int n, int k, std::size_t elements) {
+  const double budget = static_cast<double>(elements);
+  const long long side = static_cast<long long>(std::sqrt(budget / 5.0));
+  if (side < 1) {
+    throw std::invalid_argument("Memory budget is too small for MulFiles");
+  }
+  const long long kc = std::min<long long>(std::max(k, 1), side);
+  // наибольшее s с s^2 + 4 * kc * s <= elements
+  const double kc_d = static_cast<double>(kc);
+  long long s = static_cast<long long>(std::sqrt(4.0 * kc_d * kc_d + budget) -
+                                       2.0 * kc_d);
+  s = std::max(s, side);
+  TileShape shape;
+  shape.mc = static_cast<int>(std::min<long long>(std::max(m, 1), s));
+  shape.nc = static_cast<int>(std::min<long long>(std::max(n, 1), s));
+  shape.kc = static_cast<int>(kc);
+  return shape;
+}
+
+/**
+ * @brief Элементов в буферах упаковки, которые s21::kernels::Gemm выделяет
+ * для произведения тайлов shape.
+ *
+ * Малые произведения считаются без упаковки, остальные - с блоком A
+ * (не больше kGemmMc x kGemmKc) и панелью B (не больше kGemmKc x kGemmNc)
+ * на каждый поток, а потоков больше одного только от kGemmParallelVolume.
+ */
+template <typename T>
+std::size_t PackingElements(const TileShape& shape) {
+  using namespace s21::kernels;
+  const long long volume =
+      static_cast<long long>(shape.mc) * shape.nc * shape.kc;
+  if (volume <= kGemmSmallVolume) {
+    return 0;
+  }
+  const int workers = volume < kGemmParallelVolume
+                          ? 1
+                          : S21ThreadPool::Instance().GetNumThreads();
+  constexpr int kNr = GemmTraits<T>::kNr;
+  const std::size_t mc =
+      std::min(kGemmMc, (shape.mc + kGemmMr - 1) / kGemmMr * kGemmMr);
+  const std::size_t nc = std::min(kGemmNc, (shape.nc + kNr - 1) / kNr * kNr);
+  const std::size_t kc = std::min(kGemmKc, shape.kc);
+  return static_cast<std::size_t>(workers) * kc * (mc + nc);
+}
+
+/**
+ * @brief Тайлы, которые вместе с буферами упаковки ядра укладываются в
+ * elements элементов.
+ *
+ * Упаковка не растёт при уменьшении тайлов, поэтому одного пересчёта с
+ * бюджетом за вычетом упаковки исходных тайлов достаточно.
+ */
+template <typename T>
+TileShape ChooseTiles(int m, int n, int k, std::size_t elements) {
+  const TileShape shape = FitTiles(m, n, k, elements);
+  const std::size_t packing = PackingElements<T>(shape);
+  if (packing == 0) {
+    return shape;
+  }
+  if (packing >= elements) {
+    throw std::invalid_argument("Memory budget is too small for MulFiles");
+  }
+  return FitTiles(m, n, k, elements - packing);
+}
+
+/**
+ * @brief Поток упреждающего чтения тайлов.
+ *
+ * Один поток на всё умножение выполняет fetch для шага, переданного в
+ * Start; Wait дожидается окончания и пробрасывает исключение fetch.
+ */
+class Prefetcher {
+ public:
+  explicit Prefetcher(std::function<void(long long)> fetch)
+      : fetch_(std::move(fetch)), thread_(&Prefetcher::Loop, this) {}
+  Prefetcher(const Prefetcher&) = delete;
+  Prefetcher& operator=(const Prefetcher&) = delete;
+  ~Prefetcher() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    wake_.notify_one();
+    thread_.join();
+  }
+
+  void Start(long long step) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      step_ = step;
+      has_task_ = true;
+      busy_ = true;
+    }
+    wake_.notify_one();
+  }
+
+  void Wait() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return !busy_; });
+    if (error_ != nullptr) {
+      std::exception_ptr error = error_;
+      error_ = nullptr;
+      std::rethrow_exception(error);
+    }
+  }
+
+ private:
+  void Loop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+      wake_.wait(lock, [this] { return stopping_ || has_task_; });
+      if (stopping_) {
+        return;
+      }
+      has_task_ = false;
+      const long long step = step_;
+      lock.unlock();
+      std::exception_ptr error;
+      try {
+        fetch_(step);
+      } catch (...) {
+        error = std::current_exception();
+      }
+      lock.lock();
+      error_ = error;
+      busy_ = false;
+      done_.notify_all();
+    }
+  }
+
+  std::function<void(long long)> fetch_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  long long step_ = 0;
+  bool has_task_ = false;
+  bool busy_ = false;
+  bool stopping_ = false;
+  std::exception_ptr error_;
+  std::thread thread_;  // последним: запускается, когда поля готовы
+};
+
+/**
+ * @brief Удаляет временный файл результата, если он не был переименован.
+ */
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(std::string path) : path_(std::move(path)) {}
+  TemporaryFile(const TemporaryFile&) = delete;
+  TemporaryFile& operator=(const TemporaryFile&) = delete;
+  ~TemporaryFile() {
+    if (!path_.empty()) {
+      std::remove(path_.c_str());
+    }
+  }
+
+  const std::string& Path() const { return path_; }
+  void Release() { path_.clear(); }
+
+ private:
+  std::string path_;
+};
+
+}  // namespace
+
+/**
+ * @brief Перемножает матрицы из файлов и сохраняет произведение в файл.
+ *
+ * Матрицы не загружаются целиком: тайлы (по два буфера A и B для
+ * упреждающего чтения и тайл C) вместе с буферами упаковки ядра GEMM
+ * занимают не больше memory_budget байт, поэтому операнды и результат
+ * могут быть больше оперативной памяти. Тайлы следующего шага читаются
+ * одним потоком упреждающего чтения, пока считается текущий; тайл, нужный
+ * и следующему шагу, не перечитывается. Каждый тайл C
+ * считается целиком в памяти и записывается один раз. Результат
+ * записывается во временный файл и заменяет c_path атомарно, как в Save;
+ * c_path может совпадать с одним из операндов. Контрольная сумма данных
+ * операндов не сверяется (заголовки проверяются).
+ *
+ * @param a_path Файл левого множителя (m x k).
+ * @param b_path Файл правого множителя (k x n).
+ * @param c_path Файл результата (m x n).
+ * @param memory_budget Память под тайлы и упаковку в байтах.
+ * @throws std::invalid_argument Если число столбцов первой матрицы не равно
+ * числу строк второй или бюджет не вмещает пяти элементов тайлов и
+ * упаковки.
+ * @throws std::runtime_error Если файл не открывается, повреждён, хранит
+ * элементы другого типа или результат не удалось записать.
+ */
+template <typename T>
+void S21BasicMatrix<T>::MulFiles(const std::string& a_path,
+                                 const std::string& b_path,
+                                 const std::string& c_path,
+                                 std::size_t memory_budget) {
+  const Operand a(a_path, file::ElementType<T>(), sizeof(T));
+  const Operand b(b_path, file::ElementType<T>(), sizeof(T));
+  const int m = a.header.rows;
+  const int k = a.header.cols;
+  const int n = b.header.cols;
+  if (k != b.header.rows) {
+    throw std::invalid_argument(
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix for multiplication");
+  }
+  const TileShape shape = ChooseTiles<T>(m, n, k, memory_budget / sizeof(T));
+  const int mc = shape.mc;
+  const int nc = shape.nc;
+  const int kc = shape.kc;
+
+  // файл заранее получает полный размер: заполнение строк и тайлы,
+  // которые не пишутся (k == 0), остаются нулевыми
+  const int stride = FitsInline(m, n) ? n : CalcStride(n);
+  file::Header header =
+      file::MakeHeader(file::ElementType<T>(), sizeof(T), m, n, stride);
+  TemporaryFile temporary(file::TemporaryPath(c_path));
+  const file::Descriptor out(
+      ::open(temporary.Path().c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+  const auto fail = [&c_path]() {
+    throw std::runtime_error("Cannot write matrix file: " + c_path);
+  };
+  if (out.Get() < 0 ||
+      ::ftruncate(out.Get(), static_cast<off_t>(header.data_offset +
+                                                header.payload_bytes)) != 0) {
+    fail();
+  }
+
+  if (m > 0 && n > 0 && k > 0) {
+    const int tiles_m = (m + mc - 1) / mc;
+    const int tiles_n = (n + nc - 1) / nc;
+    const int panels = (k + kc - 1) / kc;
+    const long long steps = static_cast<long long>(tiles_m) * tiles_n * panels;
+
+    Tile<T> a_tiles[2];
+    Tile<T> b_tiles[2];
+    for (Tile<T>& tile : a_tiles) {
+      tile.data.resize(static_cast<std::size_t>(mc) * kc);
+    }
+    for (Tile<T>& tile : b_tiles) {
+      tile.data.resize(static_cast<std::size_t>(kc) * nc);
+    }
+    std::vector<T> c_tile(static_cast<std::size_t>(mc) * nc);
+
+    // шаг s: тайл C (ti, tj), панель p; ключи тайлов A и B
+    const auto decode = [&](long long s, int& ti, int& tj, int& p) {
+      p = static_cast<int>(s % panels);
+      tj = static_cast<int>(s / panels % tiles_n);
+      ti = static_cast<int>(s / panels / tiles_n);
+    };
+    // читает тайлы шага s в запасные буферы [1], если их там ещё нет
+    const auto fetch = [&](long long s) {
+      int ti, tj, p;
+      decode(s, ti, tj, p);
+      const long long a_key = static_cast<long long>(ti) * panels + p;
+      const long long b_key = static_cast<long long>(p) * tiles_n + tj;
+      const int rows = std::min(mc, m - ti * mc);
+      const int cols = std::min(nc, n - tj * nc);
+      const int depth = std::min(kc, k - p * kc);
+      if (a_tiles[0].key != a_key && a_tiles[1].key != a_key) {
+        a_tiles[1].key = -1;
+        if (!ReadBlock(a, ti * mc, p * kc, rows, depth,
+                       a_tiles[1].data.data())) {
+          file::ThrowCorrupted(a_path);
+        }
+        a_tiles[1].key = a_key;
+      }
+      if (b_tiles[0].key != b_key && b_tiles[1].key != b_key) {
+        b_tiles[1].key = -1;
+        if (!ReadBlock(b, p * kc, tj * nc, depth, cols,
+                       b_tiles[1].data.data())) {
+          file::ThrowCorrupted(b_path);
+        }
+        b_tiles[1].key = b_key;
+      }
+    };
+    // делает тайл шага s текущим [0]
+    const auto promote = [](Tile<T>* tiles, long long key) {
+      if (tiles[0].key != key) {
+        std::swap(tiles[0], tiles[1]);
+      }
+    };
+
+    fetch(0);
+    // после буферов тайлов: поток останавливается раньше, чем они
+    // освобождаются
+    Prefetcher prefetcher(fetch);
+    for (long long s = 0; s < steps; ++s) {
+      int ti, tj, p;
+      decode(s, ti, tj, p);
+      promote(a_tiles, static_cast<long long>(ti) * panels + p);
+      promote(b_tiles, static_cast<long long>(p) * tiles_n + tj);
+      // запасные буферы свободны: следующий шаг читается параллельно
+      if (s + 1 < steps) {
+        prefetcher.Start(s + 1);
+      }
+
+      const int rows = std::min(mc, m - ti * mc);
+      const int cols = std::min(nc, n - tj * nc);
+      const int depth = std::min(kc, k - p * kc);
+      s21::kernels::Gemm<T>(
+          rows, cols, depth, T{1}, {a_tiles[0].data.data(), depth, 1},
+          {b_tiles[0].data.data(), cols, 1}, p == 0 ? T{0} : T{1},
+          c_tile.data(), cols);
+      if (p + 1 == panels) {
+        for (int i = 0; i < rows; ++i) {
+          const std::uint64_t offset =
+              header.data_offset +
+              sizeof(T) * ((static_cast<std::uint64_t>(ti) * mc + i) * stride +
+                           static_cast<std::uint64_t>(tj) * nc);
+          if (!file::WriteAt(out.Get(),
+                             c_tile.data() + static_cast<std::size_t>(i) * cols,
+                             sizeof(T) * cols, offset)) {
+            fail();
+          }
+        }
+      }
+      if (s + 1 < steps) {
+        prefetcher.Wait();
+      }
+    }
+  }
+
+  // контрольная сумма данных - одним последовательным проходом по файлу
+  file::Checksum checksum;
+  std::vector<char> chunk(static_cast<std::size_t>(
+      std::min<std::uint64_t>(header.payload_bytes,
+                              std::max<std::size_t>(memory_budget, 4096))));
+  for (std::uint64_t done = 0; done < header.payload_bytes;) {
+    const std::size_t bytes = static_cast<std::size_t>(
+        std::min<std::uint64_t>(chunk.size(), header.payload_bytes - done));
+    if (!file::ReadAt(out.Get(), chunk.data(), bytes,
+                      header.data_offset + done)) {
+      fail();
+    }
+    checksum.Update(chunk.data(), bytes);
+    done += bytes;
+  }
+  header.payload_checksum = checksum.Digest();
+  header.header_checksum = file::HeaderChecksum(header);
+  if (!file::WriteAt(out.Get(), &header, sizeof(header), 0) ||
+      std::rename(temporary.Path().c_str(), c_path.c_str()) != 0) {
+    fail();
+  }
+  temporary.Release();
+}
+
+#define S21_INSTANTIATE_OUT_OF_CORE(T)                                    \
+  template void S21BasicMatrix<T>::MulFiles(                              \
+      const std::string&, const std::string&, const std::string&,         \
+      std::size_t);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_OUT_OF_CORE)
+#undef S21_INSTANTIATE_OUT_OF_CORE
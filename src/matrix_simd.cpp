@@ -0,0 +1,435 @@
+/**
+ * @file matrix_simd.cpp
+ * @brief Варианты поэлементных ядер для scalar/SSE2/AVX2/AVX-512 и выбор
+ * активного варианта по CPUID.
+ */
+
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+
+#include "s21_matrix_simd.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace s21::simd {
+
+namespace {
+
+// --> Скалярные ядра: эталон и вариант для процессоров без SIMD
+
+void AddScalar(double* dst, const double* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] += src[i];
+  }
+}
+
+void SubScalar(double* dst, const double* src, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] -= src[i];
+  }
+}
+
+void AddToScalar(double* dst, const double* a, const double* b,
+                 std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] = a[i] + b[i];
+  }
+}
+
+void ScaleScalar(double* dst, double num, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    dst[i] *= num;
+  }
+}
+
+bool EqualScalar(const double* a, const double* b, std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i) {
+    if (a[i] != b[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void TransposeScalar(const double* src, std::ptrdiff_t lds, double* dst,
+                     std::ptrdiff_t ldd, int rows, int cols) {
+  for (int i = 0; i < rows; ++i) {
+    const double* src_row = src + i * lds;
+    for (int j = 0; j < cols; ++j) {
+      dst[j * ldd + i] = src_row[j];
+    }
+  }
+}
+
+/**
+ * @brief Дотранспонирует правую и нижнюю кромки, не покрытые блоками
+ * block x block.
+ */
+void TransposeEdges(const double* src, std::ptrdiff_t lds, double* dst,
+                    std::ptrdiff_t ldd, int rows, int cols, int block) {
+  const int full_rows = rows / block * block;
+  const int full_cols = cols / block * block;
+  for (int i = 0; i < full_rows; ++i) {
+    for (int j = full_cols; j < cols; ++j) {
+      dst[j * ldd + i] = src[i * lds + j];
+    }
+  }
+  for (int i = full_rows; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      dst[j * ldd + i] = src[i * lds + j];
+    }
+  }
+}
+
+#ifdef S21_SIMD_X86
+
+// --> SSE2: по 2 элемента
+
+__attribute__((target("sse2"))) void AddSse2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_add_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void SubSse2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_sub_pd(_mm_loadu_pd(dst + i), _mm_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("sse2"))) void AddToSse2(double* dst, const double* a,
+                                               const double* b,
+                                               std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i,
+                  _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  AddToScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("sse2"))) void ScaleSse2(double* dst, double num,
+                                               std::size_t n) {
+  const __m128d factor = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    _mm_storeu_pd(dst + i, _mm_mul_pd(_mm_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, n - i);
+}
+
+__attribute__((target("sse2"))) bool EqualSse2(const double* a,
+                                               const double* b,
+                                               std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 2 <= n; i += 2) {
+    const __m128d neq = _mm_cmpneq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i));
+    if (_mm_movemask_pd(neq) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse2"))) void TransposeSse2(const double* src,
+                                                   std::ptrdiff_t lds,
+                                                   double* dst,
+                                                   std::ptrdiff_t ldd,
+                                                   int rows, int cols) {
+  for (int i = 0; i + 2 <= rows; i += 2) {
+    const double* s = src + i * lds;
+    for (int j = 0; j + 2 <= cols; j += 2) {
+      const __m128d r0 = _mm_loadu_pd(s + j);
+      const __m128d r1 = _mm_loadu_pd(s + lds + j);
+      _mm_storeu_pd(dst + j * ldd + i, _mm_unpacklo_pd(r0, r1));
+      _mm_storeu_pd(dst + (j + 1) * ldd + i, _mm_unpackhi_pd(r0, r1));
+    }
+  }
+  TransposeEdges(src, lds, dst, ldd, rows, cols, 2);
+}
+
+// --> AVX2: по 4 элемента
+
+__attribute__((target("avx2"))) void AddAvx2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  AddScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(double* dst, const double* src,
+                                             std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_sub_pd(_mm256_loadu_pd(dst + i),
+                                            _mm256_loadu_pd(src + i)));
+  }
+  SubScalar(dst + i, src + i, n - i);
+}
+
+__attribute__((target("avx2"))) void AddToAvx2(double* dst, const double* a,
+                                               const double* b,
+                                               std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_add_pd(_mm256_loadu_pd(a + i),
+                                            _mm256_loadu_pd(b + i)));
+  }
+  AddToScalar(dst + i, a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(double* dst, double num,
+                                               std::size_t n) {
+  const __m256d factor = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    _mm256_storeu_pd(dst + i, _mm256_mul_pd(_mm256_loadu_pd(dst + i), factor));
+  }
+  ScaleScalar(dst + i, num, n - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const double* a,
+                                               const double* b,
+                                               std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    const __m256d neq = _mm256_cmp_pd(_mm256_loadu_pd(a + i),
+                                      _mm256_loadu_pd(b + i), _CMP_NEQ_UQ);
+    if (_mm256_movemask_pd(neq) != 0) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, n - i);
+}
+
+/**
+ * @brief Транспонирование блоками 4x4 в регистрах AVX.
+ *
+ * Четыре строки блока перемешиваются unpack/permute2f128 и записываются
+ * четырьмя строками результата, без поэлементных записей с шагом.
+ */
+__attribute__((target("avx2"))) void TransposeAvx2(const double* src,
+                                                   std::ptrdiff_t lds,
+                                                   double* dst,
+                                                   std::ptrdiff_t ldd,
+                                                   int rows, int cols) {
+  for (int i = 0; i + 4 <= rows; i += 4) {
+    const double* s = src + i * lds;
+    for (int j = 0; j + 4 <= cols; j += 4) {
+      const __m256d r0 = _mm256_loadu_pd(s + j);
+      const __m256d r1 = _mm256_loadu_pd(s + lds + j);
+      const __m256d r2 = _mm256_loadu_pd(s + 2 * lds + j);
+      const __m256d r3 = _mm256_loadu_pd(s + 3 * lds + j);
+      const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+      const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+      const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+      const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+      double* d = dst + j * ldd + i;
+      _mm256_storeu_pd(d, _mm256_permute2f128_pd(t0, t2, 0x20));
+      _mm256_storeu_pd(d + ldd, _mm256_permute2f128_pd(t1, t3, 0x20));
+      _mm256_storeu_pd(d + 2 * ldd, _mm256_permute2f128_pd(t0, t2, 0x31));
+      _mm256_storeu_pd(d + 3 * ldd, _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+  }
+  TransposeEdges(src, lds, dst, ldd, rows, cols, 4);
+}
+
+// --> AVX-512: по 8 элементов, хвост - маской
+
+__attribute__((target("avx512f"))) void AddAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail,
+                        _mm512_add_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                                      _mm512_maskz_loadu_pd(tail, src + i)));
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double* dst,
+                                                  const double* src,
+                                                  std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_sub_pd(_mm512_loadu_pd(dst + i),
+                                            _mm512_loadu_pd(src + i)));
+  }
+  const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail,
+                        _mm512_sub_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                                      _mm512_maskz_loadu_pd(tail, src + i)));
+}
+
+__attribute__((target("avx512f"))) void AddToAvx512(double* dst,
+                                                    const double* a,
+                                                    const double* b,
+                                                    std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_add_pd(_mm512_loadu_pd(a + i),
+                                            _mm512_loadu_pd(b + i)));
+  }
+  const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail,
+                        _mm512_add_pd(_mm512_maskz_loadu_pd(tail, a + i),
+                                      _mm512_maskz_loadu_pd(tail, b + i)));
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double* dst, double num,
+                                                    std::size_t n) {
+  const __m512d factor = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    _mm512_storeu_pd(dst + i, _mm512_mul_pd(_mm512_loadu_pd(dst + i), factor));
+  }
+  const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  _mm512_mask_storeu_pd(dst + i, tail,
+                        _mm512_mul_pd(_mm512_maskz_loadu_pd(tail, dst + i),
+                                      factor));
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double* a,
+                                                    const double* b,
+                                                    std::size_t n) {
+  std::size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    if (_mm512_cmp_pd_mask(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i),
+                           _CMP_NEQ_UQ) != 0) {
+      return false;
+    }
+  }
+  const __mmask8 tail = static_cast<__mmask8>((1u << (n - i)) - 1);
+  return _mm512_mask_cmp_pd_mask(tail, _mm512_maskz_loadu_pd(tail, a + i),
+                                 _mm512_maskz_loadu_pd(tail, b + i),
+                                 _CMP_NEQ_UQ) == 0;
+}
+
+#endif  // S21_SIMD_X86
+
+constexpr Kernels kScalarKernels = {Isa::kScalar, AddScalar,   SubScalar,
+                                    AddToScalar,  ScaleScalar, EqualScalar,
+                                    TransposeScalar};
+#ifdef S21_SIMD_X86
+constexpr Kernels kSse2Kernels = {Isa::kSse2,   AddSse2,   SubSse2,
+                                  AddToSse2,    ScaleSse2, EqualSse2,
+                                  TransposeSse2};
+constexpr Kernels kAvx2Kernels = {Isa::kAvx2,   AddAvx2,   SubAvx2,
+                                  AddToAvx2,    ScaleAvx2, EqualAvx2,
+                                  TransposeAvx2};
+// для транспонирования блоков 4x4 хватает AVX2, который есть у всех AVX-512
+constexpr Kernels kAvx512Kernels = {Isa::kAvx512, AddAvx512,   SubAvx512,
+                                    AddToAvx512,  ScaleAvx512, EqualAvx512,
+                                    TransposeAvx2};
+#endif
+
+/**
+ * @brief Таблица ядер для набора инструкций (без проверки поддержки).
+ */
+const Kernels* TableFor(Isa isa) {
+#ifdef S21_SIMD_X86
+  switch (isa) {
+    case Isa::kAvx512:
+      return &kAvx512Kernels;
+    case Isa::kAvx2:
+      return &kAvx2Kernels;
+    case Isa::kSse2:
+      return &kSse2Kernels;
+    case Isa::kScalar:
+      break;
+  }
+#else
+  (void)isa;
+#endif
+  return &kScalarKernels;
+}
+
+/**
+ * @brief Выбор при первом обращении: лучший набор или S21_MATRIX_ISA.
+ */
+const Kernels* InitialTable() {
+  Isa isa = DetectIsa();
+  const char* env = std::getenv("S21_MATRIX_ISA");
+  if (env != nullptr) {
+    for (Isa candidate :
+         {Isa::kScalar, Isa::kSse2, Isa::kAvx2, Isa::kAvx512}) {
+      if (std::strcmp(env, IsaName(candidate)) == 0 && candidate < isa) {
+        isa = candidate;
+      }
+    }
+  }
+  return TableFor(isa);
+}
+
+std::atomic<const Kernels*>& ActiveTable() {
+  static std::atomic<const Kernels*> table(InitialTable());
+  return table;
+}
+
+}  // namespace
+
+const Kernels& Active() {
+  return *ActiveTable().load(std::memory_order_relaxed);
+}
+
+Isa ActiveIsa() { return Active().isa; }
+
+const char* IsaName(Isa isa) {
+  switch (isa) {
+    case Isa::kSse2:
+      return "sse2";
+    case Isa::kAvx2:
+      return "avx2";
+    case Isa::kAvx512:
+      return "avx512";
+    case Isa::kScalar:
+      break;
+  }
+  return "scalar";
+}
+
+Isa DetectIsa() {
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx512f")) {
+    return Isa::kAvx512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return Isa::kAvx2;
+  }
+  if (__builtin_cpu_supports("sse2")) {
+    return Isa::kSse2;
+  }
+#endif
+  return Isa::kScalar;
+}
+
+Isa SetIsa(Isa isa) {
+  const Isa best = DetectIsa();
+  if (best < isa) {
+    isa = best;
+  }
+  ActiveTable().store(TableFor(isa), std::memory_order_relaxed);
+  return isa;
+}
+
+}  // namespace s21::simd
@@ -0,0 +1,354 @@
+/**
+ * @file matrix_solve.cpp
+ * @brief Решение систем линейных уравнений: треугольные подстановки,
+ * разложение Холецкого и выбор способа по структуре матрицы.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+namespace s21::kernels {
+
+namespace {
+
+// правые части независимы, поэтому столбцы B делятся между потоками
+// полосами из целого числа строк кэша
+template <typename T>
+constexpr int kColumnStep = static_cast<int>(64 / sizeof(T));
+
+}  // namespace
+
+template <typename T>
+void SolveLower(int n, int nrhs, ConstMatrixRef<T> l, bool unit_diagonal,
+                T* b, std::ptrdiff_t ldb) {
+  S21ThreadPool::Instance().ParallelForRanges(
+      nrhs, static_cast<long long>(n) * n * nrhs, kGemmParallelVolume,
+      kColumnStep<T>, [&](int begin, int end) {
+        for (int i = 0; i < n; ++i) {
+          T* b_i = b + i * ldb;
+          for (int k = 0; k < i; ++k) {
+            const T factor = l.At(i, k);
+            if (factor == T{0}) {
+              continue;
+            }
+            const T* b_k = b + k * ldb;
+            for (int j = begin; j < end; ++j) {
+              b_i[j] -= factor * b_k[j];
+            }
+          }
+          if (!unit_diagonal) {
+            const T diagonal = l.At(i, i);
+            for (int j = begin; j < end; ++j) {
+              b_i[j] /= diagonal;
+            }
+          }
+        }
+      });
+}
+
+template <typename T>
+void SolveUpper(int n, int nrhs, ConstMatrixRef<T> u, bool unit_diagonal,
+                T* b, std::ptrdiff_t ldb) {
+  S21ThreadPool::Instance().ParallelForRanges(
+      nrhs, static_cast<long long>(n) * n * nrhs, kGemmParallelVolume,
+      kColumnStep<T>, [&](int begin, int end) {
+        for (int i = n - 1; i >= 0; --i) {
+          T* b_i = b + i * ldb;
+          for (int k = i + 1; k < n; ++k) {
+            const T factor = u.At(i, k);
+            if (factor == T{0}) {
+              continue;
+            }
+            const T* b_k = b + k * ldb;
+            for (int j = begin; j < end; ++j) {
+              b_i[j] -= factor * b_k[j];
+            }
+          }
+          if (!unit_diagonal) {
+            const T diagonal = u.At(i, i);
+            for (int j = begin; j < end; ++j) {
+              b_i[j] /= diagonal;
+            }
+          }
+        }
+      });
+}
+
+#define S21_INSTANTIATE_TRIANGULAR(T)                                \
+  template void SolveLower<T>(int, int, ConstMatrixRef<T>, bool, T*, \
+                              std::ptrdiff_t);                       \
+  template void SolveUpper<T>(int, int, ConstMatrixRef<T>, bool, T*, \
+                              std::ptrdiff_t);
+S21_MATRIX_FOR_EACH_FLOATING_TYPE(S21_INSTANTIATE_TRIANGULAR)
+#undef S21_INSTANTIATE_TRIANGULAR
+
+}  // namespace s21::kernels
+
+namespace {
+
+/**
+ * @brief Отношение наименьшего по модулю диагонального элемента к
+ * наибольшему, как PivotRatio у LU.
+ */
+template <typename T>
+double DiagonalRatio(const S21BasicMatrix<T>& a) {
+  const int n = a.GetRows();
+  if (n == 0) {
+    return 0.0;
+  }
+  T min_value = std::fabs(a(0, 0));
+  T max_value = min_value;
+  for (int k = 1; k < n; ++k) {
+    min_value = std::min(min_value, std::fabs(a(k, k)));
+    max_value = std::max(max_value, std::fabs(a(k, k)));
+  }
+  return max_value == 0.0 ? 0.0 : min_value / max_value;
+}
+
+/**
+ * @brief Проверяет, что ведущие элементы не вырождены: порог тот же, что
+ * у S21BasicMatrixLU::IsSingular.
+ *
+ * @throws std::logic_error Если система вырождена.
+ */
+void CheckRatio(double ratio, int n, double epsilon) {
+  if (ratio <= n * epsilon) {
+    throw std::logic_error("Matrix is singular, the system cannot be solved");
+  }
+}
+
+/**
+ * @brief Раскладывает матрицу на месте в L * L^T, обнуляя верхний
+ * треугольник.
+ *
+ * Столбец j считается скалярными произведениями непрерывных строк L,
+ * O(n^3 / 3) операций.
+ *
+ * @return false, если матрица не положительно определённая.
+ */
+template <typename T>
+bool FactorizeCholesky(S21BasicMatrix<T>& a) {
+  const int n = a.GetRows();
+  for (int j = 0; j < n; ++j) {
+    T* a_j = a.row(j);
+    for (int i = j; i < n; ++i) {
+      T* a_i = a.row(i);
+      T sum = a_i[j];
+      for (int k = 0; k < j; ++k) {
+        sum -= a_i[k] * a_j[k];
+      }
+      if (i == j) {
+        // NaN тоже отвергается
+        if (!(sum > T{0})) {
+          return false;
+        }
+        a_j[j] = std::sqrt(sum);
+      } else {
+        a_i[j] = sum / a_j[j];
+      }
+    }
+  }
+  for (int i = 0; i < n; ++i) {
+    std::fill(a.row(i) + i + 1, a.row(i) + n, T{0});
+  }
+  return true;
+}
+
+/**
+ * @brief Выбирает способ решения по структуре матрицы за O(n^2) чтений с
+ * ранним выходом.
+ *
+ * Диагональная и треугольные матрицы решаются подстановкой, симметричная
+ * с положительной диагональю - разложением Холецкого (необходимое условие
+ * положительной определённости), остальные - LU-разложением. Симметрия
+ * проверяется с допуском n * eps * sqrt(a_ii * a_jj): произведения вида
+ * A^T * A блочным ядром и Штрассеном симметричны лишь до округления.
+ */
+template <typename T>
+S21MatrixSolver DetectSolver(const S21BasicMatrix<T>& a) {
+  const int n = a.GetRows();
+  bool lower = true;  // над диагональю нули
+  bool upper = true;  // под диагональю нули
+  for (int i = 0; i < n && (lower || upper); ++i) {
+    const T* a_i = a.row(i);
+    for (int j = 0; j < i && upper; ++j) {
+      upper = a_i[j] == T{0};
+    }
+    for (int j = i + 1; j < n && lower; ++j) {
+      lower = a_i[j] == T{0};
+    }
+  }
+  if (lower && upper) {
+    return S21MatrixSolver::kDiagonal;
+  }
+  if (lower) {
+    return S21MatrixSolver::kLowerTriangular;
+  }
+  if (upper) {
+    return S21MatrixSolver::kUpperTriangular;
+  }
+  const double tolerance =
+      n * static_cast<double>(std::numeric_limits<T>::epsilon());
+  for (int i = 0; i < n; ++i) {
+    if (!(a(i, i) > T{0})) {
+      return S21MatrixSolver::kLU;
+    }
+    for (int j = 0; j < i; ++j) {
+      const double bound =
+          tolerance * std::sqrt(static_cast<double>(a(i, i)) * a(j, j));
+      if (std::abs(static_cast<double>(a(i, j)) - a(j, i)) > bound) {
+        return S21MatrixSolver::kLU;
+      }
+    }
+  }
+  return S21MatrixSolver::kCholesky;
+}
+
+}  // namespace
+
+/**
+ * @brief Раскладывает симметричную матрицу в A = L * L^T.
+ *
+ * @param matrix Раскладываемая матрица (читается нижний треугольник).
+ * @throws std::logic_error Если матрица не является квадратной.
+ */
+template <typename T>
+S21BasicMatrixCholesky<T>::S21BasicMatrixCholesky(
+    const S21BasicMatrix<T>& matrix)
+    : l_(matrix), positive_definite_(false) {
+  if (matrix.GetRows() != matrix.GetCols()) {
+    throw std::logic_error("Matrix must be square for Cholesky decomposition");
+  }
+  positive_definite_ = FactorizeCholesky(l_);
+}
+
+/**
+ * @brief Решает A * X = B двумя треугольными подстановками.
+ *
+ * @param b Правые части (n x nrhs).
+ * @return Решение X (n x nrhs).
+ * @throws std::invalid_argument Если число строк b не равно размеру A.
+ * @throws std::logic_error Если матрица не положительно определённая или
+ * численно вырождена.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixCholesky<T>::Solve(
+    const S21BasicMatrix<T>& b) const {
+  const int n = GetSize();
+  if (b.GetRows() != n) {
+    throw std::invalid_argument(
+        "Number of rows in the right-hand side must be equal to the size of "
+        "the matrix");
+  }
+  if (!positive_definite_) {
+    throw std::logic_error(
+        "Matrix is not positive definite, Cholesky decomposition failed");
+  }
+  // ведущие элементы LU симметричной матрицы равны квадратам диагонали L
+  const double ratio = DiagonalRatio(l_);
+  CheckRatio(ratio * ratio, n, std::numeric_limits<T>::epsilon());
+
+  S21BasicMatrix<T> x(b);
+  s21::kernels::SolveLower<T>(n, x.GetCols(), {l_.data(), l_.GetStride(), 1},
+                              false, x.data(), x.GetStride());
+  // L^T - та же матрица с переставленными шагами
+  s21::kernels::SolveUpper<T>(n, x.GetCols(), {l_.data(), 1, l_.GetStride()},
+                              false, x.data(), x.GetStride());
+  return x;
+}
+
+/**
+ * @brief Решает систему A * X = B для всех столбцов B.
+ *
+ * При kAuto способ выбирается по структуре A за O(n^2): диагональная и
+ * треугольные решаются подстановкой за O(n^2) на правую часть,
+ * симметричная с положительной диагональю - разложением Холецкого (если
+ * оно не удалось - LU), остальные - LU-разложением с частичным выбором.
+ * Явно заданный способ используется без проверки структуры. Для
+ * повторных решений с той же матрицей разложение можно сохранить: LU() и
+ * Cholesky() возвращают объекты с методом Solve.
+ *
+ * @param b Правые части (n x nrhs).
+ * @param solver Способ решения.
+ * @return Решение X (n x nrhs).
+ * @throws std::invalid_argument Если число строк b не равно размеру A.
+ * @throws std::logic_error Если матрица не квадратная или вырождена, для
+ * kCholesky - не положительно определённая, а также для целых матриц.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Solve(const S21BasicMatrix& b,
+                                           S21MatrixSolver solver) const {
+  if constexpr (std::is_integral_v<T>) {
+    throw std::logic_error(
+        "Linear system solving requires a floating-point element type");
+  } else {
+    if (rows_ != cols_) {
+      throw std::logic_error("Matrix must be square to solve a linear system");
+    }
+    if (b.rows_ != rows_) {
+      throw std::invalid_argument(
+          "Number of rows in the right-hand side must be equal to the size "
+          "of the matrix");
+    }
+    const bool detected = solver == S21MatrixSolver::kAuto;
+    if (detected) {
+      solver = DetectSolver(*this);
+    }
+    const T epsilon = std::numeric_limits<T>::epsilon();
+    switch (solver) {
+      case S21MatrixSolver::kDiagonal: {
+        CheckRatio(DiagonalRatio(*this), rows_, epsilon);
+        S21BasicMatrix x(b);
+        for (int i = 0; i < rows_; ++i) {
+          const T diagonal = (*this)(i, i);
+          T* x_i = x.row(i);
+          for (int j = 0; j < x.cols_; ++j) {
+            x_i[j] /= diagonal;
+          }
+        }
+        return x;
+      }
+      case S21MatrixSolver::kLowerTriangular:
+      case S21MatrixSolver::kUpperTriangular: {
+        CheckRatio(DiagonalRatio(*this), rows_, epsilon);
+        S21BasicMatrix x(b);
+        if (solver == S21MatrixSolver::kLowerTriangular) {
+          s21::kernels::SolveLower<T>(rows_, x.cols_, {matrix_, stride_, 1},
+                                      false, x.matrix_, x.stride_);
+        } else {
+          s21::kernels::SolveUpper<T>(rows_, x.cols_, {matrix_, stride_, 1},
+                                      false, x.matrix_, x.stride_);
+        }
+        return x;
+      }
+      case S21MatrixSolver::kCholesky: {
+        const S21BasicMatrixCholesky<T> cholesky(*this);
+        if (cholesky.IsPositiveDefinite() || !detected) {
+          return cholesky.Solve(b);
+        }
+        break;  // симметричная, но не положительно определённая
+      }
+      case S21MatrixSolver::kAuto:
+      case S21MatrixSolver::kLU:
+        break;
+    }
+    return S21BasicMatrixLU<T>(*this).Solve(b);
+  }
+}
+
+#define S21_INSTANTIATE_CHOLESKY(T) template class S21BasicMatrixCholesky<T>;
+S21_MATRIX_FOR_EACH_FLOATING_TYPE(S21_INSTANTIATE_CHOLESKY)
+#undef S21_INSTANTIATE_CHOLESKY
+
+#define S21_INSTANTIATE_SOLVE(T)                       \
+  template S21BasicMatrix<T> S21BasicMatrix<T>::Solve( \
+      const S21BasicMatrix<T>&, S21MatrixSolver) const;
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_SOLVE)
+#undef S21_INSTANTIATE_SOLVE
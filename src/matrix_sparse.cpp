@@ -0,0 +1,577 @@
+/**
+ * @file matrix_sparse.cpp
+ * @brief Реализация разреженных матриц S21BasicSparseMatrix (CSR и CSC).
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_kernels.h"
+#include "s21_sparse_matrix.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+using s21::kernels::kGemmParallelVolume;
+
+/**
+ * @brief dst[j] += alpha * src[j] для j < n в типе накопителя A.
+ */
+template <typename A, typename T>
+inline void Axpy(A* dst, T alpha, const T* src, int n) {
+  const A a = static_cast<A>(alpha);
+  for (int j = 0; j < n; ++j) {
+    dst[j] += a * static_cast<A>(src[j]);
+  }
+}
+
+/**
+ * @brief Значение не отбрасывается: модуль больше tolerance или NaN.
+ */
+template <typename T>
+inline bool IsKept(T value, double tolerance) {
+  return !(static_cast<double>(std::abs(value)) <= tolerance);
+}
+
+}  // namespace
+
+/**
+ * @brief Создаёт пустую разреженную матрицу 0x0 в формате CSR.
+ */
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix()
+    : S21BasicSparseMatrix(0, 0) {}
+
+/**
+ * @brief Создаёт нулевую разреженную матрицу.
+ *
+ * @param rows Количество строк.
+ * @param cols Количество столбцов.
+ * @param format Формат хранения.
+ * @throws std::invalid_argument Если размеры отрицательные.
+ */
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols,
+                                              S21SparseFormat format)
+    : rows_(rows), cols_(cols), format_(format) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("Matrix dimensions must be non-negative");
+  }
+  offsets_.assign(OuterSize() + 1, 0);
+}
+
+/**
+ * @brief Преобразует плотную матрицу в разреженную за один проход.
+ *
+ * CSC строится из CSR перестановкой за O(nnz), чтобы плотная матрица
+ * читалась построчно.
+ *
+ * @param dense Плотная матрица.
+ * @param format Формат хранения.
+ * @param tolerance Элементы с модулем не больше tolerance считаются
+ * нулями.
+ */
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                              S21SparseFormat format,
+                                              double tolerance)
+    : S21BasicSparseMatrix(dense.GetRows(), dense.GetCols()) {
+  for (int i = 0; i < rows_; ++i) {
+    const T* row = dense.row(i);
+    for (int j = 0; j < cols_; ++j) {
+      if (IsKept(row[j], tolerance)) {
+        indices_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    offsets_[i + 1] = static_cast<int>(indices_.size());
+  }
+  if (format == S21SparseFormat::kCsc) {
+    *this = ToCsc();
+  }
+}
+
+/**
+ * @brief Собирает матрицу из списка ненулевых элементов.
+ *
+ * Тройки могут идти в любом порядке; значения с одинаковой позицией
+ * суммируются, нулевые суммы не хранятся. Время - O(nnz log nnz).
+ *
+ * @throws std::invalid_argument Если размеры отрицательные.
+ * @throws std::out_of_range Если позиция тройки вне матрицы.
+ */
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::FromTriplets(
+    int rows, int cols, const std::vector<Triplet>& triplets,
+    S21SparseFormat format) {
+  S21BasicSparseMatrix result(rows, cols);
+  for (const Triplet& t : triplets) {
+    if (t.row < 0 || t.row >= rows || t.col < 0 || t.col >= cols) {
+      throw std::out_of_range("Triplet is out of matrix bounds");
+    }
+    ++result.offsets_[t.row + 1];
+  }
+  for (int i = 0; i < rows; ++i) {
+    result.offsets_[i + 1] += result.offsets_[i];
+  }
+
+  // раскладка по строкам подсчётом
+  std::vector<std::pair<int, T>> entries(triplets.size());
+  std::vector<int> next(result.offsets_.begin(), result.offsets_.end() - 1);
+  for (const Triplet& t : triplets) {
+    entries[next[t.row]++] = {t.col, t.value};
+  }
+
+  // сортировка внутри строк и слияние повторов; offsets_ пока хранят
+  // границы троек, границы слитых строк копятся в merged
+  std::vector<int> merged(rows + 1, 0);
+  result.indices_.reserve(entries.size());
+  result.values_.reserve(entries.size());
+  for (int i = 0; i < rows; ++i) {
+    const auto begin = entries.begin() + result.offsets_[i];
+    const auto end = entries.begin() + result.offsets_[i + 1];
+    std::sort(begin, end, [](const std::pair<int, T>& a,
+                             const std::pair<int, T>& b) {
+      return a.first < b.first;
+    });
+    for (auto it = begin; it != end;) {
+      const int col = it->first;
+      T sum = T{0};
+      for (; it != end && it->first == col; ++it) {
+        sum += it->second;
+      }
+      if (sum != T{0}) {
+        result.indices_.push_back(col);
+        result.values_.push_back(sum);
+      }
+    }
+    merged[i + 1] = static_cast<int>(result.indices_.size());
+  }
+  result.offsets_ = std::move(merged);
+
+  if (format == S21SparseFormat::kCsc) {
+    return result.ToCsc();
+  }
+  return result;
+}
+
+/**
+ * @brief Доля ненулевых элементов плотной матрицы.
+ *
+ * @return Число от 0 до 1; 0 для пустой матрицы.
+ */
+template <typename T>
+double S21BasicSparseMatrix<T>::Density(const S21BasicMatrix<T>& dense) {
+  const double size = static_cast<double>(dense.GetRows()) * dense.GetCols();
+  if (size == 0) {
+    return 0.0;
+  }
+  long long count = 0;
+  for (int i = 0; i < dense.GetRows(); ++i) {
+    const T* row = dense.row(i);
+    for (int j = 0; j < dense.GetCols(); ++j) {
+      count += row[j] != T{0};
+    }
+  }
+  return static_cast<double>(count) / size;
+}
+
+/**
+ * @brief Определяет, выгоден ли для матрицы разреженный формат.
+ *
+ * Плотная матрица распознаётся быстро: просмотр прекращается, как только
+ * ненулевых элементов становится больше порога.
+ *
+ * @param dense Плотная матрица.
+ * @param threshold Предельная доля ненулевых элементов.
+ * @return true, если ненулевых не больше threshold * rows * cols.
+ */
+template <typename T>
+bool S21BasicSparseMatrix<T>::IsSparse(const S21BasicMatrix<T>& dense,
+                                       double threshold) {
+  const double limit =
+      threshold * static_cast<double>(dense.GetRows()) * dense.GetCols();
+  long long count = 0;
+  for (int i = 0; i < dense.GetRows(); ++i) {
+    const T* row = dense.row(i);
+    for (int j = 0; j < dense.GetCols(); ++j) {
+      count += row[j] != T{0};
+    }
+    if (static_cast<double>(count) > limit) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * @brief Умножает плотные матрицы, выбирая ядро по разреженности a.
+ *
+ * Если IsSparse(a, threshold), a переводится в CSR и умножается как SpMM
+ * за O(nnz(a) * b.GetCols()), иначе выполняется обычный GEMM.
+ *
+ * @throws std::invalid_argument Если число столбцов a не равно числу строк
+ * b.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::MulAuto(const S21BasicMatrix<T>& a,
+                                                   const S21BasicMatrix<T>& b,
+                                                   double threshold) {
+  if (IsSparse(a, threshold)) {
+    return S21BasicSparseMatrix(a) * b;
+  }
+  return a * b;
+}
+
+/**
+ * @brief Преобразует матрицу в плотную.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> dense(rows_, cols_);
+  for (int o = 0; o < OuterSize(); ++o) {
+    for (int p = offsets_[o]; p < offsets_[o + 1]; ++p) {
+      if (format_ == S21SparseFormat::kCsr) {
+        dense(o, indices_[p]) = values_[p];
+      } else {
+        dense(indices_[p], o) = values_[p];
+      }
+    }
+  }
+  return dense;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToCsr() const {
+  return ToFormat(S21SparseFormat::kCsr);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToCsc() const {
+  return ToFormat(S21SparseFormat::kCsc);
+}
+
+/**
+ * @brief Переводит матрицу в заданный формат.
+ *
+ * Смена формата - перестановка подсчётом по внутренним индексам за
+ * O(nnz + rows + cols); индексы результата получаются упорядоченными.
+ */
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::ToFormat(
+    S21SparseFormat format) const {
+  if (format == format_) {
+    return *this;
+  }
+
+  S21BasicSparseMatrix result(rows_, cols_, format);
+  const int nnz = GetNonZeros();
+  for (int p = 0; p < nnz; ++p) {
+    ++result.offsets_[indices_[p] + 1];
+  }
+  for (int o = 0; o < InnerSize(); ++o) {
+    result.offsets_[o + 1] += result.offsets_[o];
+  }
+
+  result.indices_.resize(nnz);
+  result.values_.resize(nnz);
+  std::vector<int> next(result.offsets_.begin(), result.offsets_.end() - 1);
+  for (int o = 0; o < OuterSize(); ++o) {
+    for (int p = offsets_[o]; p < offsets_[o + 1]; ++p) {
+      const int dst = next[indices_[p]]++;
+      result.indices_[dst] = o;
+      result.values_[dst] = values_[p];
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Транспонирует матрицу без перестановки элементов.
+ *
+ * Массивы копируются как есть, меняются только размеры и формат.
+ */
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  S21BasicSparseMatrix result(*this);
+  std::swap(result.rows_, result.cols_);
+  result.format_ = format_ == S21SparseFormat::kCsr ? S21SparseFormat::kCsc
+                                                    : S21SparseFormat::kCsr;
+  return result;
+}
+
+/**
+ * @brief Доля ненулевых элементов; 0 для пустой матрицы.
+ */
+template <typename T>
+double S21BasicSparseMatrix<T>::GetDensity() const {
+  const double size = static_cast<double>(rows_) * cols_;
+  return size == 0 ? 0.0 : GetNonZeros() / size;
+}
+
+/**
+ * @brief Возвращает элемент (i, j) двоичным поиском по строке или столбцу.
+ *
+ * @throws std::out_of_range Если индекс вне матрицы.
+ */
+template <typename T>
+T S21BasicSparseMatrix<T>::At(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Index is out of matrix bounds");
+  }
+  const int outer = format_ == S21SparseFormat::kCsr ? i : j;
+  const int inner = format_ == S21SparseFormat::kCsr ? j : i;
+  const auto begin = indices_.begin() + offsets_[outer];
+  const auto end = indices_.begin() + offsets_[outer + 1];
+  const auto it = std::lower_bound(begin, end, inner);
+  return it != end && *it == inner ? values_[it - indices_.begin()] : T{0};
+}
+
+/**
+ * @brief SpMV: произведение на вектор за O(nnz).
+ *
+ * CSR считает скалярное произведение каждой строки (строки делятся между
+ * потоками), CSC добавляет столбцы, умноженные на x[j].
+ *
+ * @param x Вектор длины GetCols().
+ * @return Вектор длины GetRows().
+ * @throws std::invalid_argument Если длина x не равна числу столбцов.
+ */
+template <typename T>
+std::vector<T> S21BasicSparseMatrix<T>::operator*(
+    const std::vector<T>& x) const {
+  using Accumulator = typename s21::kernels::GemmTraits<T>::Accumulator;
+  if (static_cast<int>(x.size()) != cols_) {
+    throw std::invalid_argument(
+        "Vector size must be equal to the number of matrix columns for "
+        "multiplication");
+  }
+
+  std::vector<T> y(rows_);
+  if (format_ == S21SparseFormat::kCsr) {
+    S21ThreadPool::Instance().ParallelForWeightedRanges(
+        offsets_.data(), rows_, GetNonZeros(), kGemmParallelVolume,
+        [&](int begin, int end) {
+          for (int i = begin; i < end; ++i) {
+            Accumulator sum = 0;
+            for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+              sum += static_cast<Accumulator>(values_[p]) * x[indices_[p]];
+            }
+            y[i] = static_cast<T>(sum);
+          }
+        });
+  } else {
+    std::vector<Accumulator> sum(rows_);
+    for (int j = 0; j < cols_; ++j) {
+      if (x[j] != T{0}) {
+        for (int p = offsets_[j]; p < offsets_[j + 1]; ++p) {
+          sum[indices_[p]] += static_cast<Accumulator>(values_[p]) * x[j];
+        }
+      }
+    }
+    std::transform(sum.begin(), sum.end(), y.begin(),
+                   [](Accumulator value) { return static_cast<T>(value); });
+  }
+  return y;
+}
+
+/**
+ * @brief SpMM: произведение на плотную матрицу за O(nnz * dense.GetCols()).
+ *
+ * Каждый ненулевой A(i, k) добавляет строку k матрицы B, умноженную на
+ * A(i, k), к строке i результата. В CSR строки результата независимы и
+ * делятся между потоками по числу ненулевых.
+ *
+ * @throws std::invalid_argument Если число столбцов A не равно числу строк
+ * dense.
+ */
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrix<T>& dense) const {
+  using Accumulator = typename s21::kernels::GemmTraits<T>::Accumulator;
+  constexpr bool kDirect = std::is_same_v<Accumulator, T>;
+  if (cols_ != dense.GetRows()) {
+    throw std::invalid_argument(
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix for multiplication");
+  }
+
+  const int k = dense.GetCols();
+  S21BasicMatrix<T> result(rows_, k);
+  const long long volume = static_cast<long long>(GetNonZeros()) * k;
+  if (format_ == S21SparseFormat::kCsr) {
+    S21ThreadPool::Instance().ParallelForWeightedRanges(
+        offsets_.data(), rows_, volume, kGemmParallelVolume,
+        [&](int begin, int end) {
+          // целые копятся в строке long long и приводятся к T при записи
+          std::vector<Accumulator> buffer(kDirect ? 0 : k);
+          for (int i = begin; i < end; ++i) {
+            Accumulator* dst = nullptr;
+            if constexpr (kDirect) {
+              dst = result.row(i);
+            } else {
+              std::fill(buffer.begin(), buffer.end(), 0);
+              dst = buffer.data();
+            }
+            for (int p = offsets_[i]; p < offsets_[i + 1]; ++p) {
+              Axpy(dst, values_[p], dense.row(indices_[p]), k);
+            }
+            if constexpr (!kDirect) {
+              std::transform(buffer.begin(), buffer.end(), result.row(i),
+                             [](Accumulator value) {
+                               return static_cast<T>(value);
+                             });
+            }
+          }
+        });
+  } else if constexpr (kDirect) {
+    for (int j = 0; j < cols_; ++j) {
+      for (int p = offsets_[j]; p < offsets_[j + 1]; ++p) {
+        Axpy(result.row(indices_[p]), values_[p], dense.row(j), k);
+      }
+    }
+  } else {
+    std::vector<Accumulator> buffer(static_cast<std::size_t>(rows_) * k);
+    for (int j = 0; j < cols_; ++j) {
+      for (int p = offsets_[j]; p < offsets_[j + 1]; ++p) {
+        Axpy(buffer.data() + static_cast<std::size_t>(indices_[p]) * k,
+             values_[p], dense.row(j), k);
+      }
+    }
+    for (int i = 0; i < rows_; ++i) {
+      std::transform(buffer.begin() + static_cast<std::size_t>(i) * k,
+                     buffer.begin() + static_cast<std::size_t>(i + 1) * k,
+                     result.row(i),
+                     [](Accumulator value) { return static_cast<T>(value); });
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Сумма разреженных матриц слиянием строк (столбцов) за O(nnz).
+ *
+ * Правый операнд другого формата сначала переводится в формат левого.
+ * Взаимно уничтожившиеся элементы не хранятся.
+ *
+ * @throws std::invalid_argument Если размеры не совпадают.
+ */
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument(
+        "Matrices must have the same dimensions for addition");
+  }
+  if (format_ != other.format_) {
+    return *this + other.ToFormat(format_);
+  }
+
+  S21BasicSparseMatrix result(rows_, cols_, format_);
+  result.indices_.reserve(indices_.size() + other.indices_.size());
+  result.values_.reserve(values_.size() + other.values_.size());
+  auto push = [&result](int index, T value) {
+    if (value != T{0}) {
+      result.indices_.push_back(index);
+      result.values_.push_back(value);
+    }
+  };
+  for (int o = 0; o < OuterSize(); ++o) {
+    int p = offsets_[o];
+    int q = other.offsets_[o];
+    const int p_end = offsets_[o + 1];
+    const int q_end = other.offsets_[o + 1];
+    while (p < p_end && q < q_end) {
+      if (indices_[p] < other.indices_[q]) {
+        push(indices_[p], values_[p]);
+        ++p;
+      } else if (other.indices_[q] < indices_[p]) {
+        push(other.indices_[q], other.values_[q]);
+        ++q;
+      } else {
+        push(indices_[p], values_[p] + other.values_[q]);
+        ++p;
+        ++q;
+      }
+    }
+    for (; p < p_end; ++p) {
+      push(indices_[p], values_[p]);
+    }
+    for (; q < q_end; ++q) {
+      push(other.indices_[q], other.values_[q]);
+    }
+    result.offsets_[o + 1] = static_cast<int>(result.indices_.size());
+  }
+  return result;
+}
+
+/**
+ * @brief Сравнивает матрицы по значениям, независимо от формата.
+ *
+ * @return true, если размеры и все элементы совпадают.
+ */
+template <typename T>
+bool S21BasicSparseMatrix<T>::operator==(
+    const S21BasicSparseMatrix& other) const {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    return false;
+  }
+  if (format_ != other.format_) {
+    return *this == other.ToFormat(format_);
+  }
+  return offsets_ == other.offsets_ && indices_ == other.indices_ &&
+         values_ == other.values_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::OuterSize() const {
+  return format_ == S21SparseFormat::kCsr ? rows_ : cols_;
+}
+
+template <typename T>
+int S21BasicSparseMatrix<T>::InnerSize() const {
+  return format_ == S21SparseFormat::kCsr ? cols_ : rows_;
+}
+
+/**
+ * @brief Произведение плотной матрицы на разреженную.
+ *
+ * Считается как (A^T * B^T)^T: транспонирование разреженной матрицы
+ * бесплатно, а плотные транспонируются блочным ядром, так что работает
+ * то же ядро SpMM.
+ *
+ * @throws std::invalid_argument Если число столбцов dense не равно числу
+ * строк sparse.
+ */
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& dense,
+                            const S21BasicSparseMatrix<T>& sparse) {
+  if (dense.GetCols() != sparse.GetRows()) {
+    throw std::invalid_argument(
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix for multiplication");
+  }
+  return (sparse.Transpose() * dense.Transpose()).Transpose();
+}
+
+/**
+ * @brief Выводит разреженную матрицу в плотном виде.
+ */
+template <typename T>
+std::ostream& operator<<(std::ostream& os,
+                         const S21BasicSparseMatrix<T>& matrix) {
+  return os << matrix.ToDense();
+}
+
+#define S21_INSTANTIATE_SPARSE(T)                                         \
+  template class S21BasicSparseMatrix<T>;                                 \
+  template S21BasicMatrix<T> operator*(const S21BasicMatrix<T>&,          \
+                                       const S21BasicSparseMatrix<T>&);   \
+  template std::ostream& operator<<(std::ostream&,                        \
+                                    const S21BasicSparseMatrix<T>&);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_SPARSE)
+#undef S21_INSTANTIATE_SPARSE
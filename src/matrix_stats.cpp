@@ -0,0 +1,276 @@
+/**
+ * @file matrix_stats.cpp
+ * @brief Реализация счётчиков операций S21MatrixStats.
+ *
+ * Каждый поток пишет в собственный набор счётчиков (Shard) обычными
+ * сложениями без атомарных операций чтения-изменения-записи, поэтому учёт
+ * не создаёт общих для потоков строк кэша. Snapshot складывает наборы всех
+ * потоков; наборы завершившихся потоков переносятся в общий итог. Reset не
+ * трогает чужие счётчики, а запоминает текущий итог как точку отсчёта.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "s21_matrix_stats.h"
+
+namespace {
+
+constexpr int kOpCount = static_cast<int>(S21MatrixOp::kCount);
+constexpr int kBuckets = S21MatrixOpStats::kLatencyBuckets;
+
+/**
+ * @brief Счётчики одного потока.
+ *
+ * Пишет только владелец; атомарные типы с relaxed-доступом нужны, чтобы
+ * Snapshot мог читать их из другого потока, и компилируются в обычные
+ * загрузки и сохранения.
+ */
+struct alignas(64) Shard {
+  struct Op {
+    std::atomic<unsigned long long> calls{0};
+    std::atomic<unsigned long long> total_ns{0};
+    std::atomic<unsigned long long> flops{0};
+    std::atomic<unsigned long long> bytes{0};
+    std::atomic<unsigned long long> allocations{0};
+    std::atomic<unsigned long long> latency[kBuckets] = {};
+  };
+  Op ops[kOpCount];
+};
+
+void Bump(std::atomic<unsigned long long>& counter, unsigned long long value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+/**
+ * @brief Добавляет счётчики потока к итогу.
+ */
+void Accumulate(const Shard& shard, S21MatrixStatsSnapshot& total) {
+  for (int op = 0; op < kOpCount; ++op) {
+    const Shard::Op& source = shard.ops[op];
+    S21MatrixOpStats& target = total.ops[op];
+    target.calls += source.calls.load(std::memory_order_relaxed);
+    target.total_ns += source.total_ns.load(std::memory_order_relaxed);
+    target.flops += source.flops.load(std::memory_order_relaxed);
+    target.bytes += source.bytes.load(std::memory_order_relaxed);
+    target.allocations += source.allocations.load(std::memory_order_relaxed);
+    for (int i = 0; i < kBuckets; ++i) {
+      target.latency[i] += source.latency[i].load(std::memory_order_relaxed);
+    }
+  }
+}
+
+/**
+ * @brief Наборы счётчиков живых потоков и итог завершившихся.
+ *
+ * Создаётся один раз и не разрушается: потоки могут завершаться и после
+ * разрушения статических объектов.
+ */
+struct Registry {
+  std::mutex mutex;
+  std::vector<const Shard*> live;
+  S21MatrixStatsSnapshot retired = {};
+  S21MatrixStatsSnapshot baseline = {};  // итог на момент Reset
+
+  S21MatrixStatsSnapshot Total() {
+    S21MatrixStatsSnapshot total = retired;
+    for (const Shard* shard : live) {
+      Accumulate(*shard, total);
+    }
+    return total;
+  }
+};
+
+Registry& GetRegistry() {
+  static Registry* registry = new Registry;
+  return *registry;
+}
+
+/**
+ * @brief Регистрирует набор счётчиков потока на время его жизни.
+ */
+class ThreadShard {
+ public:
+  ThreadShard() {
+    Registry& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.live.push_back(&shard_);
+  }
+  ~ThreadShard() {
+    Registry& registry = GetRegistry();
+    const std::lock_guard<std::mutex> lock(registry.mutex);
+    Accumulate(shard_, registry.retired);
+    registry.live.erase(
+        std::find(registry.live.begin(), registry.live.end(), &shard_));
+  }
+  ThreadShard(const ThreadShard&) = delete;
+  ThreadShard& operator=(const ThreadShard&) = delete;
+
+  Shard& Get() { return shard_; }
+
+ private:
+  Shard shard_;
+};
+
+Shard& CurrentShard() {
+  thread_local ThreadShard shard;
+  return shard.Get();
+}
+
+// буферов матриц, выделенных текущим потоком за всё время
+thread_local unsigned long long tls_allocations = 0;
+
+/**
+ * @brief Номер корзины гистограммы: floor(log2(ns)), не больше последней.
+ */
+int LatencyBucket(unsigned long long ns) {
+  if (ns < 2) {
+    return 0;
+  }
+  return std::min(63 - __builtin_clzll(ns), kBuckets - 1);
+}
+
+}  // namespace
+
+double S21MatrixOpStats::MeanNs() const {
+  return calls == 0 ? 0.0 : static_cast<double>(total_ns) / calls;
+}
+
+S21MatrixStatsSnapshot S21MatrixStats::Snapshot() {
+  Registry& registry = GetRegistry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  S21MatrixStatsSnapshot snapshot = registry.Total();
+  for (int op = 0; op < kOpCount; ++op) {
+    S21MatrixOpStats& target = snapshot.ops[op];
+    const S21MatrixOpStats& base = registry.baseline.ops[op];
+    target.calls -= base.calls;
+    target.total_ns -= base.total_ns;
+    target.flops -= base.flops;
+    target.bytes -= base.bytes;
+    target.allocations -= base.allocations;
+    for (int i = 0; i < kBuckets; ++i) {
+      target.latency[i] -= base.latency[i];
+    }
+  }
+  return snapshot;
+}
+
+void S21MatrixStats::Reset() {
+  Registry& registry = GetRegistry();
+  const std::lock_guard<std::mutex> lock(registry.mutex);
+  registry.baseline = registry.Total();
+}
+
+const char* S21MatrixStats::OpName(S21MatrixOp op) {
+  switch (op) {
+    case S21MatrixOp::kSumMatrix:
+      return "SumMatrix";
+    case S21MatrixOp::kSubMatrix:
+      return "SubMatrix";
+    case S21MatrixOp::kMulMatrix:
+      return "MulMatrix";
+    case S21MatrixOp::kGemm:
+      return "Gemm";
+    case S21MatrixOp::kGemv:
+      return "Gemv";
+    case S21MatrixOp::kMulNumber:
+      return "MulNumber";
+    case S21MatrixOp::kTranspose:
+      return "Transpose";
+    case S21MatrixOp::kDeterminant:
+      return "Determinant";
+    case S21MatrixOp::kInverseMatrix:
+      return "InverseMatrix";
+    case S21MatrixOp::kCalcComplements:
+      return "CalcComplements";
+    case S21MatrixOp::kGetMatrixMinor:
+      return "GetMatrixMinor";
+    case S21MatrixOp::kCopyConstructor:
+      return "CopyConstructor";
+    case S21MatrixOp::kCopyAssignment:
+      return "CopyAssignment";
+    case S21MatrixOp::kCount:
+      break;
+  }
+  return "Unknown";
+}
+
+void S21MatrixStats::Record(S21MatrixOp op, unsigned long long ns,
+                            unsigned long long flops, unsigned long long bytes,
+                            unsigned long long allocations) {
+  Shard::Op& target = CurrentShard().ops[static_cast<int>(op)];
+  Bump(target.calls, 1);
+  Bump(target.total_ns, ns);
+  Bump(target.flops, flops);
+  Bump(target.bytes, bytes);
+  Bump(target.allocations, allocations);
+  Bump(target.latency[LatencyBucket(ns)], 1);
+}
+
+void S21MatrixStats::CountAllocation() { ++tls_allocations; }
+
+unsigned long long S21MatrixStats::ThreadAllocations() {
+  return tls_allocations;
+}
+
+S21MatrixStatsScope::S21MatrixStatsScope(S21MatrixOp op,
+                                         unsigned long long flops,
+                                         unsigned long long bytes)
+    : op_(op),
+      flops_(flops),
+      bytes_(bytes),
+      allocations_(tls_allocations),
+      start_(std::chrono::steady_clock::now()) {}
+
+S21MatrixStatsScope::~S21MatrixStatsScope() {
+  const auto elapsed = std::chrono::steady_clock::now() - start_;
+  S21MatrixStats::Record(
+      op_,
+      static_cast<unsigned long long>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count()),
+      flops_, bytes_, tls_allocations - allocations_);
+}
+
+/**
+ * @brief Сериализует снимок в JSON.
+ *
+ * Гистограмма задержек - массив из kLatencyBuckets счётчиков, корзина i
+ * покрывает [2^i, 2^(i + 1)) нс.
+ */
+std::string S21MatrixStatsSnapshot::ToJson() const {
+  std::string json = "{\"enabled\": ";
+  json += S21MatrixStats::kEnabled ? "true" : "false";
+  json += ", \"operations\": {";
+  for (int op = 0; op < kOpCount; ++op) {
+    const S21MatrixOpStats& stats = ops[op];
+    char fields[256];
+    std::snprintf(fields, sizeof(fields),
+                  "\"calls\": %llu, \"total_ns\": %llu, \"flops\": %llu, "
+                  "\"bytes\": %llu, \"allocations\": %llu",
+                  stats.calls, stats.total_ns, stats.flops, stats.bytes,
+                  stats.allocations);
+    if (op > 0) {
+      json += ", ";
+    }
+    json += "\"";
+    json += S21MatrixStats::OpName(static_cast<S21MatrixOp>(op));
+    json += "\": {";
+    json += fields;
+    json += ", \"latency_ns_log2_histogram\": [";
+    for (int i = 0; i < kBuckets; ++i) {
+      if (i > 0) {
+        json += ", ";
+      }
+      json += std::to_string(stats.latency[i]);
+    }
+    json += "]}";
+  }
+  json += "}}";
+  return json;
+}
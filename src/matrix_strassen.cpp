@@ -0,0 +1,298 @@
+/**
+ * @file matrix_strassen.cpp
+ * @brief Умножение матриц по схеме Штрассена-Винограда.
+ *
+ * Каждый уровень рекурсии заменяет 8 произведений половинного размера на 7
+ * и 15 сложений. Порядок операций взят из работы Boyer, Dumas, Pernet,
+ * Zhou "Memory efficient scheduling of Strassen-Winograd's matrix
+ * multiplication algorithm" (2009): промежуточные суммы и произведения
+ * пишутся в четверти C и в два временных блока X и Y, так что уровню нужна
+ * память только под X и Y. Рабочая память всех уровней выделяется одним
+ * буфером до начала рекурсии. Листья считаются блочным Gemm.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+#include "s21_thread_pool.h"
+
+namespace s21::kernels {
+
+namespace {
+
+// Поэлементные проходы от стольких элементов делятся между потоками пула
+constexpr long long kStrassenParallelElements = 1 << 16;
+
+/**
+ * @brief dst = x op y для блоков rows x cols с шагами строк.
+ *
+ * dst может совпадать с x или y.
+ */
+template <typename T, typename Op>
+void Combine(int rows, int cols, T* dst, std::ptrdiff_t ldd, const T* x,
+             std::ptrdiff_t ldx, const T* y, std::ptrdiff_t ldy, Op op) {
+  const auto body = [&](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      T* d = dst + i * ldd;
+      const T* xi = x + i * ldx;
+      const T* yi = y + i * ldy;
+      for (int j = 0; j < cols; ++j) {
+        d[j] = op(xi[j], yi[j]);
+      }
+    }
+  };
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  const int threads = pool.GetNumThreads();
+  if (threads == 1 ||
+      static_cast<long long>(rows) * cols < kStrassenParallelElements) {
+    body(0, rows);
+    return;
+  }
+  const int chunks = std::min(rows, threads);
+  pool.ParallelFor(chunks, [&](int c) {
+    body(static_cast<int>(static_cast<long long>(rows) * c / chunks),
+         static_cast<int>(static_cast<long long>(rows) * (c + 1) / chunks));
+  });
+}
+
+template <typename T>
+void Add(int rows, int cols, T* dst, std::ptrdiff_t ldd, const T* x,
+         std::ptrdiff_t ldx, const T* y, std::ptrdiff_t ldy) {
+  Combine(rows, cols, dst, ldd, x, ldx, y, ldy,
+          [](T u, T v) { return u + v; });
+}
+
+template <typename T>
+void Sub(int rows, int cols, T* dst, std::ptrdiff_t ldd, const T* x,
+         std::ptrdiff_t ldx, const T* y, std::ptrdiff_t ldy) {
+  Combine(rows, cols, dst, ldd, x, ldx, y, ldy,
+          [](T u, T v) { return u - v; });
+}
+
+/**
+ * @brief Элементов рабочей памяти для рекурсии глубины depth над
+ * произведением (m x k) * (k x n), размеры кратны 2^depth.
+ */
+std::size_t WorkspaceSize(int m, int n, int k, int depth) {
+  std::size_t size = 0;
+  for (int level = 0; level < depth; ++level) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    size += static_cast<std::size_t>(m) * std::max(k, n) +
+            static_cast<std::size_t>(k) * n;
+  }
+  return size;
+}
+
+/**
+ * @brief C = A * B рекурсией Штрассена-Винограда глубины depth.
+ *
+ * Размеры кратны 2^depth, строки всех матриц лежат непрерывно.
+ *
+ * @param workspace Рабочая память WorkspaceSize(m, n, k, depth) элементов.
+ */
+template <typename T>
+void Winograd(int m, int n, int k, const T* a, std::ptrdiff_t lda, const T* b,
+              std::ptrdiff_t ldb, T* c, std::ptrdiff_t ldc, int depth,
+              T* workspace) {
+  if (depth == 0) {
+    Gemm<T>(m, n, k, T{1}, {a, lda, 1}, {b, ldb, 1}, T{0}, c, ldc);
+    return;
+  }
+  const int hm = m / 2;
+  const int hn = n / 2;
+  const int hk = k / 2;
+  const T* a11 = a;
+  const T* a12 = a + hk;
+  const T* a21 = a + hm * lda;
+  const T* a22 = a21 + hk;
+  const T* b11 = b;
+  const T* b12 = b + hn;
+  const T* b21 = b + hk * ldb;
+  const T* b22 = b21 + hn;
+  T* c11 = c;
+  T* c12 = c + hn;
+  T* c21 = c + hm * ldc;
+  T* c22 = c21 + hn;
+  // X - суммы четвертей A (hm x hk), затем P1 (hm x hn); Y - суммы
+  // четвертей B (hk x hn)
+  const std::ptrdiff_t ldx = std::max(hk, hn);
+  T* x = workspace;
+  T* y = x + hm * ldx;
+  T* next = y + static_cast<std::ptrdiff_t>(hk) * hn;
+  const auto multiply = [&](const T* p, std::ptrdiff_t ldp, const T* q,
+                            std::ptrdiff_t ldq, T* r) {
+    Winograd(hm, hn, hk, p, ldp, q, ldq, r, ldc, depth - 1, next);
+  };
+
+  Sub(hm, hk, x, ldx, a11, lda, a21, lda);  // S3 = A11 - A21
+  Sub(hk, hn, y, hn, b22, ldb, b12, ldb);   // T3 = B22 - B12
+  multiply(x, ldx, y, hn, c21);             // P7 = S3 * T3
+  Add(hm, hk, x, ldx, a21, lda, a22, lda);  // S1 = A21 + A22
+  Sub(hk, hn, y, hn, b12, ldb, b11, ldb);   // T1 = B12 - B11
+  multiply(x, ldx, y, hn, c22);             // P5 = S1 * T1
+  Sub(hm, hk, x, ldx, x, ldx, a11, lda);    // S2 = S1 - A11
+  Sub(hk, hn, y, hn, b22, ldb, y, hn);      // T2 = B22 - T1
+  multiply(x, ldx, y, hn, c11);             // P6 = S2 * T2
+  Sub(hm, hk, x, ldx, a12, lda, x, ldx);    // S4 = A12 - S2
+  multiply(x, ldx, b22, ldb, c12);          // P3 = S4 * B22
+  // P1 = A11 * B11
+  Winograd(hm, hn, hk, a11, lda, b11, ldb, x, ldx, depth - 1, next);
+  Add(hm, hn, c11, ldc, x, ldx, c11, ldc);    // U2 = P1 + P6
+  Add(hm, hn, c21, ldc, c11, ldc, c21, ldc);  // U3 = U2 + P7
+  Add(hm, hn, c11, ldc, c11, ldc, c22, ldc);  // U4 = U2 + P5
+  Add(hm, hn, c22, ldc, c21, ldc, c22, ldc);  // C22 = U7 = U3 + P5
+  Add(hm, hn, c12, ldc, c11, ldc, c12, ldc);  // C12 = U5 = U4 + P3
+  Sub(hk, hn, y, hn, y, hn, b21, ldb);        // T4 = T2 - B21
+  multiply(a22, lda, y, hn, c11);             // P4 = A22 * T4
+  Sub(hm, hn, c21, ldc, c21, ldc, c11, ldc);  // C21 = U6 = U3 - P4
+  multiply(a12, lda, b21, ldb, c11);          // P2 = A12 * B21
+  Add(hm, hn, c11, ldc, c11, ldc, x, ldx);    // C11 = U1 = P1 + P2
+}
+
+/**
+ * @brief Копирует матрицу rows x cols в непрерывный буфер с шагом ld,
+ * дополненный нулями.
+ */
+template <typename T>
+void Pad(int rows, int cols, ConstMatrixRef<T> src, T* dst,
+         std::ptrdiff_t ld) {
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      dst[i * ld + j] = src.At(i, j);
+    }
+  }
+}
+
+/**
+ * @brief Округляет value вверх до кратного step.
+ */
+int RoundUp(int value, int step) { return (value + step - 1) / step * step; }
+
+}  // namespace
+
+int StrassenDepth(int m, int n, int k, int crossover) {
+  int depth = 0;
+  while (std::max({m, n, k}) > crossover && std::min({m, n, k}) > 1) {
+    m = (m + 1) / 2;
+    n = (n + 1) / 2;
+    k = (k + 1) / 2;
+    ++depth;
+  }
+  return depth;
+}
+
+template <typename T>
+void Strassen(int m, int n, int k, ConstMatrixRef<T> a, ConstMatrixRef<T> b,
+              T* c, std::ptrdiff_t ldc, int crossover) {
+  if (m <= 0 || n <= 0) {
+    return;
+  }
+  const int depth = StrassenDepth(m, n, k, crossover);
+  if (depth == 0) {
+    Gemm<T>(m, n, k, T{1}, a, b, T{0}, c, ldc);
+    return;
+  }
+  // размеры дополняются нулями до кратных 2^depth: лишние строки и столбцы
+  // дают нулевые слагаемые
+  const int step = 1 << depth;
+  const int pm = RoundUp(m, step);
+  const int pn = RoundUp(n, step);
+  const int pk = RoundUp(k, step);
+  const bool pad_a = pm != m || pk != k || a.col_stride != 1;
+  const bool pad_b = pk != k || pn != n || b.col_stride != 1;
+  const bool pad_c = pm != m || pn != n;
+
+  std::vector<T> buffer(
+      WorkspaceSize(pm, pn, pk, depth) +
+      (pad_a ? static_cast<std::size_t>(pm) * pk : 0) +
+      (pad_b ? static_cast<std::size_t>(pk) * pn : 0) +
+      (pad_c ? static_cast<std::size_t>(pm) * pn : 0));
+  T* spare = buffer.data() + WorkspaceSize(pm, pn, pk, depth);
+  const T* a_data = a.data;
+  std::ptrdiff_t lda = a.row_stride;
+  if (pad_a) {
+    Pad(m, k, a, spare, pk);
+    a_data = spare;
+    lda = pk;
+    spare += static_cast<std::ptrdiff_t>(pm) * pk;
+  }
+  const T* b_data = b.data;
+  std::ptrdiff_t ldb = b.row_stride;
+  if (pad_b) {
+    Pad(k, n, b, spare, pn);
+    b_data = spare;
+    ldb = pn;
+    spare += static_cast<std::ptrdiff_t>(pk) * pn;
+  }
+  if (!pad_c) {
+    // m = pm и n = pn, но k мог быть дополнен до pk
+    Winograd(pm, pn, pk, a_data, lda, b_data, ldb, c, ldc, depth,
+             buffer.data());
+    return;
+  }
+  Winograd(pm, pn, pk, a_data, lda, b_data, ldb, spare, pn, depth,
+           buffer.data());
+  for (int i = 0; i < m; ++i) {
+    std::copy(spare + i * static_cast<std::ptrdiff_t>(pn),
+              spare + i * static_cast<std::ptrdiff_t>(pn) + n, c + i * ldc);
+  }
+}
+
+#define S21_INSTANTIATE_STRASSEN(T)                           \
+  template void Strassen<T>(int, int, int, ConstMatrixRef<T>, \
+                            ConstMatrixRef<T>, T*, std::ptrdiff_t, int);
+S21_MATRIX_FOR_EACH_FLOATING_TYPE(S21_INSTANTIATE_STRASSEN)
+#undef S21_INSTANTIATE_STRASSEN
+
+}  // namespace s21::kernels
+
+namespace {
+
+/**
+ * @brief Хранилище порога Штрассена для типа T.
+ */
+template <typename T>
+std::atomic<int>& StrassenCrossover() {
+  static std::atomic<int> crossover(s21::kernels::kStrassenCrossover);
+  return crossover;
+}
+
+}  // namespace
+
+/**
+ * @brief Возвращает порог Штрассена-Винограда: наибольшую сторону листа
+ * рекурсии, который умножается блочным GEMM.
+ */
+template <typename T>
+int S21BasicMatrix<T>::GetStrassenCrossover() {
+  return StrassenCrossover<T>().load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Задаёт порог Штрассена-Винограда для всех потоков.
+ *
+ * При kAuto квадратные произведения со стороной больше порога считаются по
+ * Штрассену-Винограду.
+ *
+ * @param crossover Наибольшая сторона листа рекурсии.
+ * @throws std::invalid_argument Если crossover меньше 1.
+ */
+template <typename T>
+void S21BasicMatrix<T>::SetStrassenCrossover(int crossover) {
+  if (crossover < 1) {
+    throw std::invalid_argument("Strassen crossover must be positive");
+  }
+  StrassenCrossover<T>().store(crossover, std::memory_order_relaxed);
+}
+
+#define S21_INSTANTIATE_CROSSOVER(T)                      \
+  template int S21BasicMatrix<T>::GetStrassenCrossover(); \
+  template void S21BasicMatrix<T>::SetStrassenCrossover(int);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_CROSSOVER)
+#undef S21_INSTANTIATE_CROSSOVER
@@ -0,0 +1,213 @@
+/**
+ * @file matrix_thread_pool.cpp
+ * @brief Реализация постоянного пула потоков S21ThreadPool.
+ */
+
+#include <cstdlib>
+#include <stdexcept>
+
+#include "s21_thread_pool.h"
+
+namespace {
+
+// true в потоках пула и в вызывающем потоке на время ParallelFor: вложенные
+// вызовы выполняются последовательно, чтобы не ждать сами себя
+thread_local bool tls_inside_pool = false;
+
+/**
+ * @brief Число потоков по умолчанию: S21_MATRIX_NUM_THREADS или число ядер.
+ */
+int DefaultNumThreads() {
+  const char* env = std::getenv("S21_MATRIX_NUM_THREADS");
+  if (env != nullptr) {
+    const int value = std::atoi(env);
+    if (value > 0) {
+      return value;
+    }
+  }
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return hardware > 0 ? static_cast<int>(hardware) : 1;
+}
+
+}  // namespace
+
+/**
+ * @brief Возвращает пул, которым пользуется библиотека.
+ *
+ * Пул создаётся при первом обращении и живёт до завершения программы.
+ */
+S21ThreadPool& S21ThreadPool::Instance() {
+  static S21ThreadPool pool(DefaultNumThreads());
+  return pool;
+}
+
+/**
+ * @brief Создаёт пул из num_threads потоков (включая вызывающий).
+ *
+ * @param num_threads Число потоков; значения меньше 1 заменяются на 1.
+ */
+S21ThreadPool::S21ThreadPool(int num_threads)
+    : num_threads_(1),
+      body_(nullptr),
+      task_count_(0),
+      next_task_(0),
+      busy_workers_(0),
+      generation_(0),
+      stopping_(false) {
+  Start(num_threads);
+}
+
+/**
+ * @brief Останавливает и присоединяет рабочие потоки.
+ */
+S21ThreadPool::~S21ThreadPool() { Stop(); }
+
+/**
+ * @brief Возвращает число потоков, участвующих в ParallelFor.
+ */
+int S21ThreadPool::GetNumThreads() const {
+  return num_threads_.load(std::memory_order_relaxed);
+}
+
+/**
+ * @brief Меняет число потоков пула.
+ *
+ * Дожидается окончания текущего ParallelFor и пересоздаёт рабочие потоки.
+ *
+ * @param num_threads Новое число потоков; значения меньше 1 заменяются на 1.
+ * @throws std::logic_error Если вызван из задачи ParallelFor: внешний вызов
+ * держит пул, и ожидание его окончания никогда бы не завершилось.
+ */
+void S21ThreadPool::SetNumThreads(int num_threads) {
+  if (tls_inside_pool) {
+    throw std::logic_error(
+        "SetNumThreads cannot be called from a ParallelFor task");
+  }
+  std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+  Stop();
+  Start(num_threads);
+}
+
+/**
+ * @brief Выполняет body(0) ... body(count - 1) на потоках пула.
+ *
+ * Задачи раздаются через атомарный счётчик, вызывающий поток выполняет их
+ * наравне с рабочими. Если пул однопоточный или вызов вложенный, задачи
+ * выполняются последовательно. Исключение первой упавшей задачи
+ * пробрасывается вызывающему после завершения остальных.
+ *
+ * @param count Число задач.
+ * @param body Функция, выполняющая задачу с заданным номером.
+ */
+void S21ThreadPool::ParallelFor(int count,
+                                const std::function<void(int)>& body) {
+  if (count <= 0) {
+    return;
+  }
+  if (num_threads_.load(std::memory_order_relaxed) == 1 || count == 1 ||
+      tls_inside_pool) {
+    for (int task = 0; task < count; ++task) {
+      body(task);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> submit_lock(submit_mutex_);
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    task_count_ = count;
+    next_task_.store(0);
+    busy_workers_ = static_cast<int>(workers_.size());
+    error_ = nullptr;
+    ++generation_;
+  }
+  wake_.notify_all();
+
+  tls_inside_pool = true;
+  RunTasks();
+  tls_inside_pool = false;
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [this] { return busy_workers_ == 0; });
+  body_ = nullptr;
+  if (error_ != nullptr) {
+    std::exception_ptr error = error_;
+    error_ = nullptr;
+    std::rethrow_exception(error);
+  }
+}
+
+/**
+ * @brief Запускает num_threads - 1 рабочих потоков.
+ */
+void S21ThreadPool::Start(int num_threads) {
+  num_threads = num_threads > 0 ? num_threads : 1;
+  num_threads_.store(num_threads, std::memory_order_relaxed);
+  stopping_ = false;
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this, generation_);
+  }
+}
+
+/**
+ * @brief Останавливает и присоединяет все рабочие потоки.
+ */
+void S21ThreadPool::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+/**
+ * @brief Цикл рабочего потока: ждёт новое поколение задач и выполняет их.
+ *
+ * @param seen_generation Поколение на момент запуска потока. Передаётся
+ * извне, чтобы поток, стартовавший позже первого ParallelFor, не пропустил
+ * его задачи.
+ */
+void S21ThreadPool::WorkerLoop(unsigned long long seen_generation) {
+  tls_inside_pool = true;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] {
+        return stopping_ || generation_ != seen_generation;
+      });
+      if (stopping_) {
+        return;
+      }
+      seen_generation = generation_;
+    }
+
+    RunTasks();
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--busy_workers_ == 0) {
+      done_.notify_all();
+    }
+  }
+}
+
+/**
+ * @brief Забирает задачи из общего счётчика, пока они не кончатся.
+ */
+void S21ThreadPool::RunTasks() {
+  for (int task = next_task_.fetch_add(1); task < task_count_;
+       task = next_task_.fetch_add(1)) {
+    try {
+      (*body_)(task);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (error_ == nullptr) {
+        error_ = std::current_exception();
+      }
+    }
+  }
+}
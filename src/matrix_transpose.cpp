@@ -0,0 +1,127 @@
+/**
+ * @file matrix_transpose.cpp
+ * @brief Кэш-независимое (cache-oblivious) транспонирование.
+ *
+ * Матрица рекурсивно делится пополам по большей стороне, пока блок не станет
+ * не больше kTransposeBlock x kTransposeBlock. Такой блок и его образ
+ * помещаются в L1 и транспонируются векторным ядром s21::simd (double) или
+ * простым циклом (остальные типы), а на любом уровне иерархии памяти
+ * источник и приёмник читаются и пишутся блоками, а не столбцами с шагом в
+ * целую строку.
+ */
+
+#include <cstring>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_simd.h"
+
+namespace s21::kernels {
+
+namespace {
+
+// Середина отрезка длины n, кратная размеру регистрового блока ядер
+int Half(int n) { return (n / 2 + 3) / 4 * 4; }
+
+// Листовой блок не больше kTransposeBlock x kTransposeBlock
+template <typename T>
+void TransposeLeaf(const simd::Kernels& simd, const T* src, std::ptrdiff_t lds,
+                   T* dst, std::ptrdiff_t ldd, int rows, int cols) {
+  if constexpr (std::is_same_v<T, double>) {
+    simd.transpose(src, lds, dst, ldd, rows, cols);
+  } else {
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        dst[j * ldd + i] = src[i * lds + j];
+      }
+    }
+  }
+}
+
+template <typename T>
+void TransposeRecursive(const simd::Kernels& simd, const T* src,
+                        std::ptrdiff_t lds, T* dst, std::ptrdiff_t ldd,
+                        int rows, int cols) {
+  if (rows <= kTransposeBlock && cols <= kTransposeBlock) {
+    TransposeLeaf(simd, src, lds, dst, ldd, rows, cols);
+  } else if (rows >= cols) {
+    const int half = Half(rows);
+    TransposeRecursive(simd, src, lds, dst, ldd, half, cols);
+    TransposeRecursive(simd, src + half * lds, lds, dst + half, ldd,
+                       rows - half, cols);
+  } else {
+    const int half = Half(cols);
+    TransposeRecursive(simd, src, lds, dst, ldd, rows, half);
+    TransposeRecursive(simd, src + half, lds, dst + half * ldd, ldd, rows,
+                       cols - half);
+  }
+}
+
+/**
+ * @brief Меняет местами upper (rows x cols) и lower (cols x rows) с
+ * транспонированием: upper = lower^T, lower = upper^T.
+ */
+template <typename T>
+void SwapTransposed(const simd::Kernels& simd, T* upper, T* lower,
+                    std::ptrdiff_t ld, int rows, int cols) {
+  if (rows <= kTransposeBlock && cols <= kTransposeBlock) {
+    // буфер на стеке: 8 КБ при блоке 32 для double
+    T buffer[kTransposeBlock * kTransposeBlock];
+    TransposeLeaf(simd, upper, ld, buffer, kTransposeBlock, rows, cols);
+    TransposeLeaf(simd, lower, ld, upper, ld, cols, rows);
+    for (int i = 0; i < cols; ++i) {
+      std::memcpy(lower + i * ld, buffer + i * kTransposeBlock,
+                  sizeof(T) * rows);
+    }
+  } else if (rows >= cols) {
+    const int half = Half(rows);
+    SwapTransposed(simd, upper, lower, ld, half, cols);
+    SwapTransposed(simd, upper + half * ld, lower + half, ld, rows - half,
+                   cols);
+  } else {
+    const int half = Half(cols);
+    SwapTransposed(simd, upper, lower, ld, rows, half);
+    SwapTransposed(simd, upper + half, lower + half * ld, ld, rows,
+                   cols - half);
+  }
+}
+
+template <typename T>
+void TransposeSquareRecursive(const simd::Kernels& simd, T* a,
+                              std::ptrdiff_t lda, int n) {
+  if (n <= kTransposeBlock) {
+    for (int i = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j) {
+        std::swap(a[i * lda + j], a[j * lda + i]);
+      }
+    }
+    return;
+  }
+  const int half = Half(n);
+  TransposeSquareRecursive(simd, a, lda, half);
+  TransposeSquareRecursive(simd, a + half * lda + half, lda, n - half);
+  SwapTransposed(simd, a + half, a + half * lda, lda, half, n - half);
+}
+
+}  // namespace
+
+template <typename T>
+void Transpose(const T* src, std::ptrdiff_t lds, T* dst, std::ptrdiff_t ldd,
+               int rows, int cols) {
+  TransposeRecursive(simd::Active(), src, lds, dst, ldd, rows, cols);
+}
+
+template <typename T>
+void TransposeSquareInPlace(T* a, std::ptrdiff_t lda, int n) {
+  TransposeSquareRecursive(simd::Active(), a, lda, n);
+}
+
+#define S21_INSTANTIATE_TRANSPOSE(T)                                       \
+  template void Transpose<T>(const T*, std::ptrdiff_t, T*, std::ptrdiff_t, \
+                             int, int);                                    \
+  template void TransposeSquareInPlace<T>(T*, std::ptrdiff_t, int);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_TRANSPOSE)
+#undef S21_INSTANTIATE_TRANSPOSE
+
+}  // namespace s21::kernels
@@ -0,0 +1,440 @@
+/**
+ * @file matrix_view.cpp
+ * @brief Реализация невладеющих представлений S21BasicMatrixView.
+ *
+ * Представления ссылаются на буфер исходной матрицы и не копируют данные:
+ * блоки и миноры передаются в умножение, сравнение и определитель без
+ * выделения памяти под копию.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <initializer_list>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_kernels.h"
+#include "s21_matrix_oop.h"
+
+namespace {
+
+/**
+ * @brief Делит [0, n) на отрезки, внутри которых пропуски skip1 и skip2 не
+ * нарушают непрерывность индексов в исходном буфере.
+ *
+ * @param points Массив не менее чем из 4 элементов, получает границы
+ * отрезков 0 = points[0] < ... < points[count] = n.
+ * @return Число отрезков count (0 для n = 0).
+ */
+int Segments(int n, int skip1, int skip2, int* points) {
+  if (skip1 > skip2) {
+    std::swap(skip1, skip2);
+  }
+  int count = 0;
+  points[0] = 0;
+  for (int bound : {skip1, skip2, n}) {
+    if (bound > points[count] && bound <= n) {
+      points[++count] = bound;
+    }
+  }
+  return count;
+}
+
+/**
+ * @brief Точный определитель целочисленного представления алгоритмом
+ * Барейса.
+ *
+ * Все деления выполняются нацело, а промежуточные значения - миноры
+ * исходной матрицы, поэтому в long long помещается всё, что помещается
+ * сам определитель. O(n^3) операций.
+ */
+template <typename T>
+long long BareissDeterminant(const S21BasicMatrixView<T>& view) {
+  const int n = view.GetRows();
+  std::vector<long long> m(static_cast<std::size_t>(n) * n);
+  const auto row = [&m, n](int i) {
+    return m.data() + static_cast<std::size_t>(i) * n;
+  };
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      row(i)[j] = view.At(i, j);
+    }
+  }
+
+  long long sign = 1, previous = 1;
+  for (int k = 0; k + 1 < n; ++k) {
+    if (row(k)[k] == 0) {
+      int pivot = k + 1;
+      while (pivot < n && row(pivot)[k] == 0) {
+        ++pivot;
+      }
+      if (pivot == n) {
+        return 0;  // столбец нулевой
+      }
+      std::swap_ranges(row(k), row(k) + n, row(pivot));
+      sign = -sign;
+    }
+    for (int i = k + 1; i < n; ++i) {
+      for (int j = k + 1; j < n; ++j) {
+        row(i)[j] = (row(i)[j] * row(k)[k] - row(i)[k] * row(k)[j]) / previous;
+      }
+    }
+    previous = row(k)[k];
+  }
+  return sign * row(n - 1)[n - 1];
+}
+
+}  // namespace
+
+/**
+ * @brief Создаёт представление всей матрицы.
+ *
+ * @param matrix Исходная матрица.
+ */
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(const S21BasicMatrix<T>& matrix)
+    : S21BasicMatrixView(matrix.data(), matrix.GetRows(), matrix.GetCols(),
+                         matrix.GetStride()) {}
+
+/**
+ * @brief Создаёт представление произвольного буфера.
+ *
+ * @param data Указатель на левый верхний элемент.
+ * @param rows Число строк представления.
+ * @param cols Число столбцов представления.
+ * @param stride Шаг строки исходного буфера (в элементах), шаг столбца - 1.
+ * @param skip_row Пропускаемая строка (в индексах представления) или -1.
+ * @param skip_col Пропускаемый столбец или -1.
+ * @throws std::invalid_argument Если размеры отрицательны.
+ */
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(const T* data, int rows, int cols,
+                                          std::ptrdiff_t stride, int skip_row,
+                                          int skip_col)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      row_stride_(stride),
+      col_stride_(1),
+      skip_row_(skip_row < 0 ? kNoSkip : skip_row),
+      skip_col_(skip_col < 0 ? kNoSkip : skip_col) {
+  if (rows < 0 || cols < 0) {
+    throw std::invalid_argument("Matrix dimensions must be non-negative");
+  }
+}
+
+/**
+ * @brief Возвращает представление блока текущего представления.
+ *
+ * @param row Первая строка блока.
+ * @param col Первый столбец блока.
+ * @param rows Число строк блока.
+ * @param cols Число столбцов блока.
+ * @return Представление блока; пропуски внутри блока сохраняются.
+ * @throws std::out_of_range Если блок выходит за границы.
+ */
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Block(int row, int col, int rows,
+                                                   int cols) const {
+  if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+      col + cols > cols_) {
+    throw std::out_of_range("Block is out of matrix bounds");
+  }
+  S21BasicMatrixView block = *this;
+  block.data_ = Address(row, col);
+  block.rows_ = rows;
+  block.cols_ = cols;
+  block.skip_row_ = row < skip_row_ && skip_row_ != kNoSkip
+                        ? skip_row_ - row
+                        : kNoSkip;
+  block.skip_col_ = col < skip_col_ && skip_col_ != kNoSkip
+                        ? skip_col_ - col
+                        : kNoSkip;
+  return block;
+}
+
+/**
+ * @brief Возвращает транспонированное представление за O(1).
+ *
+ * Меняются местами размеры, шаги и пропуски; данные не копируются.
+ */
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Transposed() const {
+  S21BasicMatrixView transposed = *this;
+  std::swap(transposed.rows_, transposed.cols_);
+  std::swap(transposed.row_stride_, transposed.col_stride_);
+  std::swap(transposed.skip_row_, transposed.skip_col_);
+  return transposed;
+}
+
+/**
+ * @brief Вычисляет определитель представления.
+ *
+ * До 3x3 - по явной формуле без выделения памяти, большие вещественные -
+ * через LU-разложение копии, большие целые - точно, алгоритмом Барейса.
+ * Произведения целых элементов вычисляются в long long.
+ *
+ * @return Определитель.
+ * @throws std::logic_error Если представление не квадратное.
+ */
+template <typename T>
+double S21BasicMatrixView<T>::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::logic_error(
+        "Matrix must be square to calculate its determinant");
+  }
+
+  using Wide = std::conditional_t<std::is_integral_v<T>, long long, T>;
+  const auto m = [this](int i, int j) { return static_cast<Wide>(At(i, j)); };
+  switch (rows_) {
+    case 0:
+      return 0.0;
+    case 1:
+      return m(0, 0);
+    case 2:
+      return m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0);
+    case 3:
+      return m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) -
+             m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0)) +
+             m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+    default:
+      if constexpr (std::is_integral_v<T>) {
+        return static_cast<double>(BareissDeterminant(*this));
+      } else {
+        return S21BasicMatrixLU<T>(S21BasicMatrix<T>(*this)).Determinant();
+      }
+  }
+}
+
+/**
+ * @brief Возвращает представление блока матрицы.
+ *
+ * @throws std::out_of_range Если блок выходит за границы матрицы.
+ */
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int row, int col, int rows,
+                                               int cols) const {
+  return S21BasicMatrixView<T>(*this).Block(row, col, rows, cols);
+}
+
+/**
+ * @brief Возвращает транспонированное представление матрицы за O(1).
+ */
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::TransposeView() const {
+  return S21BasicMatrixView<T>(*this).Transposed();
+}
+
+/**
+ * @brief Записывает в матрицу того же размера копию представления.
+ *
+ * Построчные представления копируются memcpy, транспонированные без
+ * пропусков - блочным s21::kernels::Transpose, остальные - поэлементно.
+ */
+template <typename T>
+void S21BasicMatrix<T>::EvaluateView(const S21BasicMatrixView<T>& view) {
+  if (view.IsRowContiguous()) {
+    for (int i = 0; i < rows_; ++i) {
+      std::memcpy(row(i), view.Address(i, 0), sizeof(T) * cols_);
+    }
+  } else if (view.GetRowStride() == 1 && view.GetSkipRow() < 0 &&
+             view.GetSkipCol() < 0) {
+    // view - транспонированный построчный буфер с шагом GetColStride()
+    s21::kernels::Transpose(view.data(), view.GetColStride(), matrix_,
+                            stride_, cols_, rows_);
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      for (int j = 0; j < cols_; ++j) {
+        row(i)[j] = view.At(i, j);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Умножает текущую матрицу на представление.
+ *
+ * Транспонированные представления передаются в Gemm с переставленными
+ * шагами (вариант NT), копия не создаётся.
+ *
+ * @throws std::invalid_argument Если число столбцов текущей матрицы не равно
+ * числу строк представления.
+ */
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrixView<T>& other) {
+  *this = *this * other;
+}
+
+/**
+ * @brief Перегруженный оператор присваивания умножения на представление
+ */
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(
+    const S21BasicMatrixView<T>& other) {
+  MulMatrix(other);
+  return *this;
+}
+
+/**
+ * @brief Возвращает представление минора без строки row и столбца col.
+ *
+ * @throws std::out_of_range Если row или col вне матрицы.
+ */
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::MinorView(int row, int col) const {
+  if (row < 0 || row >= rows_ || col < 0 || col >= cols_) {
+    throw std::out_of_range("Minor index is out of matrix bounds");
+  }
+  return S21BasicMatrixView<T>(matrix_, rows_ - 1, cols_ - 1, stride_, row,
+                               col);
+}
+
+/**
+ * @brief Умножает представления блочным ядром Gemm.
+ *
+ * Шаги представлений передаются в Gemm как есть, поэтому транспонированные
+ * множители (варианты TN, NT, TT) не копируются. Пропуски делят каждое
+ * измерение не более чем на три непрерывных отрезка, произведение
+ * складывается из Gemm по их сочетаниям.
+ *
+ * @return Произведение lhs * rhs.
+ * @throws std::invalid_argument Если число столбцов lhs не равно числу
+ * строк rhs.
+ */
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& lhs,
+                            const S21BasicMatrixView<T>& rhs) {
+  if (lhs.GetCols() != rhs.GetRows()) {
+    throw std::invalid_argument(
+        "Number of columns in the first matrix must be equal to the number of "
+        "rows in the second matrix for multiplication");
+  }
+
+  S21BasicMatrix<T> result(lhs.GetRows(), rhs.GetCols());
+  int rows[4], inner[4], cols[4];
+  const int row_count = Segments(lhs.GetRows(), lhs.GetSkipRow(), -1, rows);
+  const int inner_count =
+      Segments(lhs.GetCols(), lhs.GetSkipCol(), rhs.GetSkipRow(), inner);
+  const int col_count = Segments(rhs.GetCols(), rhs.GetSkipCol(), -1, cols);
+
+  for (int r = 0; r < row_count; ++r) {
+    for (int c = 0; c < col_count; ++c) {
+      for (int p = 0; p < inner_count; ++p) {
+        s21::kernels::Gemm<T>(
+            rows[r + 1] - rows[r], cols[c + 1] - cols[c],
+            inner[p + 1] - inner[p], T{1},
+            {lhs.Address(rows[r], inner[p]), lhs.GetRowStride(),
+             lhs.GetColStride()},
+            {rhs.Address(inner[p], cols[c]), rhs.GetRowStride(),
+             rhs.GetColStride()},
+            p == 0 ? T{0} : T{1}, result.row(rows[r]) + cols[c],
+            result.GetStride());
+      }
+    }
+  }
+  return result;
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& lhs,
+                            const S21BasicMatrixView<T>& rhs) {
+  return S21BasicMatrixView<T>(lhs) * rhs;
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& lhs,
+                            const S21BasicMatrix<T>& rhs) {
+  return lhs * S21BasicMatrixView<T>(rhs);
+}
+
+/**
+ * @brief Сравнивает представления поэлементно.
+ *
+ * Непрерывные строки сравниваются векторным ядром, остальные -
+ * поэлементно.
+ *
+ * @return true, если размеры и все элементы совпадают.
+ */
+template <typename T>
+bool operator==(const S21BasicMatrixView<T>& lhs,
+                const S21BasicMatrixView<T>& rhs) {
+  if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols()) {
+    return false;
+  }
+
+  if (!lhs.IsRowContiguous() || !rhs.IsRowContiguous()) {
+    for (int i = 0; i < lhs.GetRows(); ++i) {
+      for (int j = 0; j < lhs.GetCols(); ++j) {
+        if (lhs.At(i, j) != rhs.At(i, j)) {
+          return false;
+        }
+      }
+    }
+    return true;
+  }
+
+  for (int i = 0; i < lhs.GetRows(); ++i) {
+    if (!s21::kernels::Equal(lhs.Address(i, 0), rhs.Address(i, 0),
+                             lhs.GetCols())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename T>
+bool operator==(const S21BasicMatrix<T>& lhs,
+                const S21BasicMatrixView<T>& rhs) {
+  return S21BasicMatrixView<T>(lhs) == rhs;
+}
+
+template <typename T>
+bool operator==(const S21BasicMatrixView<T>& lhs,
+                const S21BasicMatrix<T>& rhs) {
+  return lhs == S21BasicMatrixView<T>(rhs);
+}
+
+/**
+ * @brief Выводит представление в поток в формате operator<< для матрицы.
+ */
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const S21BasicMatrixView<T>& view) {
+  for (int i = 0; i < view.GetRows(); ++i) {
+    for (int j = 0; j < view.GetCols(); ++j) {
+      os << view(i, j) << " ";
+    }
+    os << std::endl;
+  }
+  return os;
+}
+
+#define S21_INSTANTIATE_VIEWS(T)                                              \
+  template class S21BasicMatrixView<T>;                                       \
+  template S21BasicMatrixView<T> S21BasicMatrix<T>::Block(int, int, int, int) \
+      const;                                                                  \
+  template S21BasicMatrixView<T> S21BasicMatrix<T>::TransposeView() const;    \
+  template void S21BasicMatrix<T>::EvaluateView(                              \
+      const S21BasicMatrixView<T>&);                                          \
+  template void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrixView<T>&);   \
+  template S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(                  \
+      const S21BasicMatrixView<T>&);                                          \
+  template S21BasicMatrixView<T> S21BasicMatrix<T>::MinorView(int, int)       \
+      const;                                                                  \
+  template S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>&,          \
+                                       const S21BasicMatrixView<T>&);         \
+  template S21BasicMatrix<T> operator*(const S21BasicMatrix<T>&,              \
+                                       const S21BasicMatrixView<T>&);         \
+  template S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>&,          \
+                                       const S21BasicMatrix<T>&);             \
+  template bool operator==(const S21BasicMatrixView<T>&,                      \
+                           const S21BasicMatrixView<T>&);                     \
+  template bool operator==(const S21BasicMatrix<T>&,                          \
+                           const S21BasicMatrixView<T>&);                     \
+  template bool operator==(const S21BasicMatrixView<T>&,                      \
+                           const S21BasicMatrix<T>&);                         \
+  template std::ostream& operator<<(std::ostream&,                            \
+                                    const S21BasicMatrixView<T>&);
+S21_MATRIX_FOR_EACH_TYPE(S21_INSTANTIATE_VIEWS)
+#undef S21_INSTANTIATE_VIEWS
@@ -0,0 +1,373 @@
+/**
+ * @file s21_fixed_matrix.h
+ * @brief Матрицы фиксированного размера R x C с хранением внутри объекта.
+ *
+ * Размеры - параметры шаблона, поэтому их несовпадение обнаруживается при
+ * компиляции, память в куче не выделяется, а поэлементные операции и
+ * умножение развёрнуты без циклов. Определитель и обратная матрица до 4x4
+ * вычисляются по явным формулам. Всё, кроме обращения вырожденной матрицы,
+ * доступно в constexpr-вычислениях.
+ *
+ * S21FixedMatrix - лист шаблонов выражений, поэтому S21Matrix(fixed),
+ * dynamic + fixed и сравнение с S21Matrix работают без дополнительного
+ * кода; обратное преобразование проверяет размеры во время выполнения.
+ */
+
+#ifndef S21_FIXED_MATRIX_H
+#define S21_FIXED_MATRIX_H
+
+#include <iostream>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+
+namespace s21::fixed {
+
+/**
+ * @brief Вызывает f(std::integral_constant<int, I>{}) для I = 0 ... N - 1.
+ *
+ * Каждый вызов - отдельное выражение свёртки, цикла нет ни в исходном, ни
+ * в неоптимизированном коде.
+ */
+template <typename F, int... I>
+constexpr void Unroll(F&& f, std::integer_sequence<int, I...>) {
+  (f(std::integral_constant<int, I>{}), ...);
+}
+
+template <int N, typename F>
+constexpr void Unroll(F&& f) {
+  Unroll(f, std::make_integer_sequence<int, N>{});
+}
+
+}  // namespace s21::fixed
+
+/**
+ * @class S21FixedMatrix
+ * @brief Матрица R x C с элементами типа T в массиве внутри объекта.
+ */
+template <int R, int C, typename T = double>
+class S21FixedMatrix : public S21MatrixExpr<S21FixedMatrix<R, C, T>> {
+  static_assert(R > 0 && C > 0, "Fixed matrix dimensions must be positive");
+
+ public:
+  using value_type = T;
+
+  // нулевая матрица
+  constexpr S21FixedMatrix() : data_{} {}
+
+  /**
+   * @brief Создаёт матрицу из R * C значений в построчном порядке.
+   *
+   * Явный: S21Matrix2 m = 5 не компилируется, а при другом числе значений
+   * конструктор не участвует в разрешении перегрузки.
+   */
+  template <typename... Values,
+            typename = std::enable_if_t<
+                sizeof...(Values) == R * C &&
+                std::conjunction_v<std::is_arithmetic<Values>...>>>
+  constexpr explicit S21FixedMatrix(Values... values)
+      : data_{static_cast<T>(values)...} {}
+
+  /**
+   * @brief Копирует матрицу, представление или выражение того же размера.
+   *
+   * @throws std::invalid_argument Если размеры не равны R x C.
+   */
+  template <typename E>
+  explicit S21FixedMatrix(const S21MatrixExpr<E>& expr) : data_{} {
+    const E& source = expr.Self();
+    if (source.GetRows() != R || source.GetCols() != C) {
+      throw std::invalid_argument(
+          "Matrix dimensions must match the fixed matrix size");
+    }
+    for (int i = 0; i < R; ++i) {
+      for (int j = 0; j < C; ++j) {
+        (*this)(i, j) = static_cast<T>(source.At(i, j));
+      }
+    }
+  }
+
+  static constexpr S21FixedMatrix Identity() {
+    static_assert(R == C, "Identity matrix must be square");
+    S21FixedMatrix identity;
+    s21::fixed::Unroll<R>([&](auto i) { identity(i, i) = T{1}; });
+    return identity;
+  }
+
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+
+  constexpr T* data() noexcept { return data_; }
+  constexpr const T* data() const noexcept { return data_; }
+
+  constexpr T& operator()(int i, int j) { return data_[i * C + j]; }
+  constexpr const T& operator()(int i, int j) const {
+    return data_[i * C + j];
+  }
+
+  // элемент как значение листа выражения; буфер не пересекается с чужим
+  constexpr T At(int i, int j) const { return data_[i * C + j]; }
+  bool Overlaps(const void*, const void*) const { return false; }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) {
+    s21::fixed::Unroll<R * C>([&](auto k) { data_[k] += other.data_[k]; });
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) {
+    s21::fixed::Unroll<R * C>([&](auto k) { data_[k] -= other.data_[k]; });
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(double num) {
+    s21::fixed::Unroll<R * C>(
+        [&](auto k) { data_[k] = static_cast<T>(data_[k] * num); });
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(const S21FixedMatrix& other) {
+    static_assert(R == C, "Only square fixed matrices can be multiplied "
+                          "in place");
+    return *this = *this * other;
+  }
+
+  constexpr bool operator==(const S21FixedMatrix& other) const {
+    bool equal = true;
+    s21::fixed::Unroll<R * C>(
+        [&](auto k) { equal = equal && data_[k] == other.data_[k]; });
+    return equal;
+  }
+
+  constexpr S21FixedMatrix<C, R, T> Transpose() const {
+    S21FixedMatrix<C, R, T> transposed;
+    s21::fixed::Unroll<R * C>([&](auto k) {
+      transposed(k % C, k / C) = data_[k];
+    });
+    return transposed;
+  }
+
+  constexpr T Determinant() const;
+  constexpr S21FixedMatrix InverseMatrix() const;
+
+ private:
+  // минор 2x2 на строках r0, r1 и столбцах c0, c1
+  constexpr T Minor2(int r0, int r1, int c0, int c1) const {
+    const S21FixedMatrix& m = *this;
+    return m(r0, c0) * m(r1, c1) - m(r0, c1) * m(r1, c0);
+  }
+
+  // |det| / П max|row_i| <= n * eps: отношение не зависит от масштаба
+  // строк и ограничено n^(n/2) по неравенству Адамара
+  constexpr bool IsSingular(T determinant) const;
+
+  T data_[R * C];
+};
+
+// --> Операторы над матрицами фиксированного размера
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator+(
+    S21FixedMatrix<R, C, T> lhs, const S21FixedMatrix<R, C, T>& rhs) {
+  return lhs += rhs;
+}
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator-(
+    S21FixedMatrix<R, C, T> lhs, const S21FixedMatrix<R, C, T>& rhs) {
+  return lhs -= rhs;
+}
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator*(S21FixedMatrix<R, C, T> matrix,
+                                            double num) {
+  return matrix *= num;
+}
+
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator*(double num,
+                                            S21FixedMatrix<R, C, T> matrix) {
+  return matrix *= num;
+}
+
+/**
+ * @brief Произведение (R x K) * (K x C): размеры проверяются при
+ * компиляции, все R * C * K умножений развёрнуты.
+ */
+template <int R, int K, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> operator*(
+    const S21FixedMatrix<R, K, T>& lhs, const S21FixedMatrix<K, C, T>& rhs) {
+  S21FixedMatrix<R, C, T> result;
+  s21::fixed::Unroll<R * C>([&](auto k) {
+    constexpr int i = decltype(k)::value / C;
+    constexpr int j = decltype(k)::value % C;
+    T sum{};
+    s21::fixed::Unroll<K>([&](auto p) { sum += lhs(i, p) * rhs(p, j); });
+    result(i, j) = sum;
+  });
+  return result;
+}
+
+/**
+ * @brief Произведения с динамической матрицей.
+ *
+ * @throws std::invalid_argument Если число столбцов левого множителя не
+ * равно числу строк правого.
+ */
+template <int R, int C, typename T>
+S21BasicMatrix<T> operator*(const S21FixedMatrix<R, C, T>& lhs,
+                            const S21BasicMatrix<T>& rhs) {
+  return S21BasicMatrix<T>(lhs) * rhs;
+}
+
+template <int R, int C, typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& lhs,
+                            const S21FixedMatrix<R, C, T>& rhs) {
+  return lhs * S21BasicMatrix<T>(rhs);
+}
+
+/**
+ * @brief Выводит матрицу в поток в формате operator<< для S21Matrix.
+ */
+template <int R, int C, typename T>
+std::ostream& operator<<(std::ostream& os,
+                         const S21FixedMatrix<R, C, T>& matrix) {
+  for (int i = 0; i < R; ++i) {
+    for (int j = 0; j < C; ++j) {
+      os << matrix(i, j) << " ";
+    }
+    os << std::endl;
+  }
+  return os;
+}
+
+// --> Определитель и обратная матрица
+
+/**
+ * @brief Вычисляет определитель.
+ *
+ * До 4x4 - по явным формулам (4x4 - разложение Лапласа по двум первым
+ * строкам через миноры 2x2), большие - через S21BasicMatrix::Determinant.
+ *
+ * @return Определитель в типе элементов.
+ */
+template <int R, int C, typename T>
+constexpr T S21FixedMatrix<R, C, T>::Determinant() const {
+  static_assert(R == C, "Matrix must be square to calculate its determinant");
+  const S21FixedMatrix& m = *this;
+  if constexpr (R == 1) {
+    return m(0, 0);
+  } else if constexpr (R == 2) {
+    return Minor2(0, 1, 0, 1);
+  } else if constexpr (R == 3) {
+    return m(0, 0) * Minor2(1, 2, 1, 2) - m(0, 1) * Minor2(1, 2, 0, 2) +
+           m(0, 2) * Minor2(1, 2, 0, 1);
+  } else if constexpr (R == 4) {
+    return Minor2(0, 1, 0, 1) * Minor2(2, 3, 2, 3) -
+           Minor2(0, 1, 0, 2) * Minor2(2, 3, 1, 3) +
+           Minor2(0, 1, 0, 3) * Minor2(2, 3, 1, 2) +
+           Minor2(0, 1, 1, 2) * Minor2(2, 3, 0, 3) -
+           Minor2(0, 1, 1, 3) * Minor2(2, 3, 0, 2) +
+           Minor2(0, 1, 2, 3) * Minor2(2, 3, 0, 1);
+  } else {
+    return static_cast<T>(S21BasicMatrix<T>(*this).Determinant());
+  }
+}
+
+template <int R, int C, typename T>
+constexpr bool S21FixedMatrix<R, C, T>::IsSingular(T determinant) const {
+  const auto abs = [](T value) { return value < T{0} ? -value : value; };
+  // деление по строкам не переполняется и не теряет порядок, как det^2
+  T ratio = abs(determinant);
+  for (int i = 0; i < R; ++i) {
+    T row_max = T{0};
+    for (int j = 0; j < C; ++j) {
+      row_max = row_max < abs(At(i, j)) ? abs(At(i, j)) : row_max;
+    }
+    if (row_max == T{0}) {
+      return true;
+    }
+    ratio /= row_max;
+  }
+  return ratio <= R * std::numeric_limits<T>::epsilon();
+}
+
+/**
+ * @brief Вычисляет обратную матрицу.
+ *
+ * До 4x4 - через присоединённую матрицу по явным формулам, большие - через
+ * S21BasicMatrix::InverseMatrix.
+ *
+ * @return Обратная матрица.
+ * @throws std::logic_error Если матрица вырождена: |det| относительно
+ * произведения наибольших по модулю элементов строк не превышает
+ * n * epsilon.
+ */
+template <int R, int C, typename T>
+constexpr S21FixedMatrix<R, C, T> S21FixedMatrix<R, C, T>::InverseMatrix()
+    const {
+  static_assert(R == C, "Matrix must be square to calculate its inverse");
+  static_assert(std::is_floating_point_v<T>,
+                "Matrix inverse requires a floating-point element type");
+  if constexpr (R > 4) {
+    return S21FixedMatrix(S21BasicMatrix<T>(*this).InverseMatrix());
+  } else {
+    const T determinant = Determinant();
+    if (IsSingular(determinant)) {
+      throw std::logic_error(
+          "Matrix is singular, its inverse cannot be calculated");
+    }
+    const T inv = T{1} / determinant;
+    const S21FixedMatrix& m = *this;
+    S21FixedMatrix r;
+    if constexpr (R == 1) {
+      r(0, 0) = inv;
+    } else if constexpr (R == 2) {
+      r = S21FixedMatrix(m(1, 1), -m(0, 1), -m(1, 0), m(0, 0)) * inv;
+    } else if constexpr (R == 3) {
+      // присоединённая матрица: r(j, i) - алгебраическое дополнение (i, j)
+      s21::fixed::Unroll<9>([&](auto k) {
+        constexpr int i = decltype(k)::value / 3;
+        constexpr int j = decltype(k)::value % 3;
+        r(j, i) = Minor2((i + 1) % 3, (i + 2) % 3, (j + 1) % 3, (j + 2) % 3) *
+                  inv;
+      });
+    } else {
+      const T s0 = Minor2(0, 1, 0, 1), s1 = Minor2(0, 1, 0, 2),
+              s2 = Minor2(0, 1, 0, 3), s3 = Minor2(0, 1, 1, 2),
+              s4 = Minor2(0, 1, 1, 3), s5 = Minor2(0, 1, 2, 3);
+      const T c0 = Minor2(2, 3, 0, 1), c1 = Minor2(2, 3, 0, 2),
+              c2 = Minor2(2, 3, 0, 3), c3 = Minor2(2, 3, 1, 2),
+              c4 = Minor2(2, 3, 1, 3), c5 = Minor2(2, 3, 2, 3);
+      r = S21FixedMatrix(
+          m(1, 1) * c5 - m(1, 2) * c4 + m(1, 3) * c3,
+          -m(0, 1) * c5 + m(0, 2) * c4 - m(0, 3) * c3,
+          m(3, 1) * s5 - m(3, 2) * s4 + m(3, 3) * s3,
+          -m(2, 1) * s5 + m(2, 2) * s4 - m(2, 3) * s3,
+          -m(1, 0) * c5 + m(1, 2) * c2 - m(1, 3) * c1,
+          m(0, 0) * c5 - m(0, 2) * c2 + m(0, 3) * c1,
+          -m(3, 0) * s5 + m(3, 2) * s2 - m(3, 3) * s1,
+          m(2, 0) * s5 - m(2, 2) * s2 + m(2, 3) * s1,
+          m(1, 0) * c4 - m(1, 1) * c2 + m(1, 3) * c0,
+          -m(0, 0) * c4 + m(0, 1) * c2 - m(0, 3) * c0,
+          m(3, 0) * s4 - m(3, 1) * s2 + m(3, 3) * s0,
+          -m(2, 0) * s4 + m(2, 1) * s2 - m(2, 3) * s0,
+          -m(1, 0) * c3 + m(1, 1) * c1 - m(1, 2) * c0,
+          m(0, 0) * c3 - m(0, 1) * c1 + m(0, 2) * c0,
+          -m(3, 0) * s3 + m(3, 1) * s1 - m(3, 2) * s0,
+          m(2, 0) * s3 - m(2, 1) * s1 + m(2, 2) * s0);
+      r *= inv;
+    }
+    return r;
+  }
+}
+
+// --> Распространённые размеры
+
+using S21Matrix2 = S21FixedMatrix<2, 2>;
+using S21Matrix3 = S21FixedMatrix<3, 3>;
+using S21Matrix4 = S21FixedMatrix<4, 4>;
+
+#endif  // S21_FIXED_MATRIX_H
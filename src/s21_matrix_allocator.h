@@ -0,0 +1,100 @@
+/**
+ * @file s21_matrix_allocator.h
+ * @brief Подключаемые распределители памяти для буферов S21Matrix.
+ *
+ * Каждый буфер матрицы выделяется через текущий распределитель потока
+ * (S21MatrixAllocator::Current()) и несёт перед данными заголовок с
+ * указателем на распределитель, поэтому освобождается правильно, даже если
+ * матрица пережила область, в которой была создана.
+ *
+ * Встроенные распределители:
+ * - Global() - ::operator new с выравниванием 64 байта (по умолчанию);
+ * - Pool() - потоковый кэш блоков по классам размеров (степени двойки);
+ * - S21MatrixArena - арена на время вычисления, выделяет блоки сдвигом
+ *   указателя и переиспользует память, когда все её блоки освобождены.
+ */
+
+#ifndef S21_MATRIX_ALLOCATOR_H
+#define S21_MATRIX_ALLOCATOR_H
+
+#include <cstddef>
+
+/**
+ * @brief Счётчики распределителей (общие для всех потоков).
+ */
+struct S21MatrixAllocatorStats {
+  unsigned long long allocations;         // запросов буферов матриц
+  unsigned long long pool_hits;           // выдано из кэша пула
+  unsigned long long pool_misses;         // запросов к пулу мимо кэша
+  unsigned long long arena_allocations;   // выдано аренами
+  unsigned long long system_allocations;  // обращений к ::operator new
+
+  // доля запросов к пулу, обслуженных из его кэша
+  double HitRate() const;
+};
+
+/**
+ * @class S21MatrixAllocator
+ * @brief Интерфейс распределителя буферов матриц.
+ *
+ * Allocate должен возвращать память, выровненную на 64 байта. Собственный
+ * распределитель должен жить дольше всех выделенных им буферов.
+ */
+class S21MatrixAllocator {
+ public:
+  virtual ~S21MatrixAllocator() = default;
+
+  virtual void* Allocate(std::size_t bytes) = 0;
+  virtual void Deallocate(void* ptr, std::size_t bytes) noexcept = 0;
+
+  // распределитель, которым текущий поток создаёт новые матрицы
+  static S21MatrixAllocator& Current();
+  static S21MatrixAllocator& Global();
+  static S21MatrixAllocator& Pool();
+
+  static S21MatrixAllocatorStats GetStats();
+  static void ResetStats();
+};
+
+/**
+ * @class S21MatrixAllocatorScope
+ * @brief Делает распределитель текущим для потока до конца области.
+ */
+class S21MatrixAllocatorScope {
+ public:
+  explicit S21MatrixAllocatorScope(S21MatrixAllocator& allocator);
+  ~S21MatrixAllocatorScope();
+
+  S21MatrixAllocatorScope(const S21MatrixAllocatorScope&) = delete;
+  S21MatrixAllocatorScope& operator=(const S21MatrixAllocatorScope&) = delete;
+
+ private:
+  S21MatrixAllocator* previous_;
+};
+
+/**
+ * @class S21MatrixArena
+ * @brief Арена для временных матриц, текущая для потока до конца области.
+ *
+ * Блоки выделяются сдвигом указателя в кусках по chunk_bytes байт. Когда
+ * все блоки арены освобождены, указатель возвращается в начало, и те же
+ * куски используются снова без обращения к malloc. Матрицы, пережившие
+ * арену, остаются действительными: куски освобождаются вместе с последним
+ * блоком.
+ */
+class S21MatrixArena {
+ public:
+  explicit S21MatrixArena(std::size_t chunk_bytes = kDefaultChunkBytes);
+  ~S21MatrixArena();
+
+  S21MatrixArena(const S21MatrixArena&) = delete;
+  S21MatrixArena& operator=(const S21MatrixArena&) = delete;
+
+  static constexpr std::size_t kDefaultChunkBytes = 4 << 20;
+
+ private:
+  S21MatrixAllocator* resource_;
+  S21MatrixAllocator* previous_;
+};
+
+#endif  // S21_MATRIX_ALLOCATOR_H
@@ -0,0 +1,133 @@
+/**
+ * @file s21_matrix_batch.h
+ * @brief Пакет из многих матриц одного размера в чередующемся (SoA)
+ * размещении.
+ *
+ * Матрицы пакета разбиты на блоки по kLanes штук. Внутри блока элемент
+ * (i, j) всех его матриц лежит подряд, в одной строке кэша, поэтому каждая
+ * арифметическая операция ядра выполняется сразу для kLanes матриц: одна
+ * матрица - одна позиция векторного регистра. Блок малых матриц (до 8x8)
+ * целиком помещается в L1, а пакет хранится одним буфером, так что
+ * операции не выделяют память на каждую матрицу и не вызывают методов
+ * S21BasicMatrix.
+ */
+
+#ifndef S21_MATRIX_BATCH_H
+#define S21_MATRIX_BATCH_H
+
+#include <cstddef>
+#include <new>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @class S21BasicMatrixBatch
+ * @brief Пакет из count матриц rows x cols с элементами типа T.
+ *
+ * Операции применяются к каждой матрице пакета независимо (к парам
+ * матриц с одинаковыми номерами для двух пакетов). При объёме от
+ * s21::kernels::kGemmParallelVolume и более чем одном потоке в
+ * S21ThreadPool::Instance() блоки раздаются пулу; с одним потоком пула
+ * пакет обрабатывается последовательно.
+ *
+ * Инстанцирован для типов S21_MATRIX_FOR_EACH_TYPE. Как и в GEMM, целые
+ * произведения копятся в long long; определители целых матриц считаются в
+ * double, обращение для них недоступно.
+ */
+template <typename T>
+class S21BasicMatrixBatch {
+ public:
+  using value_type = T;
+
+  // матриц в блоке: элемент (i, j) блока занимает одну строку кэша
+  static constexpr int kLanes = static_cast<int>(64 / sizeof(T));
+
+  S21BasicMatrixBatch();  // пустой пакет
+  // count нулевых матриц rows x cols
+  S21BasicMatrixBatch(int count, int rows, int cols);
+  // из матриц одного размера
+  explicit S21BasicMatrixBatch(const std::vector<S21BasicMatrix<T>>& matrices);
+
+  int GetCount() const { return count_; }
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+
+  // элемент (i, j) матрицы index
+  T& operator()(int index, int i, int j) { return data_[Offset(index, i, j)]; }
+  T operator()(int index, int i, int j) const {
+    return data_[Offset(index, i, j)];
+  }
+  // копия матрицы index и запись матрицы на её место
+  S21BasicMatrix<T> Get(int index) const;
+  void Set(int index, const S21BasicMatrix<T>& matrix);
+
+  // [k] += other[k]
+  void SumMatrix(const S21BasicMatrixBatch& other);
+  // [k] = [k] * other[k]
+  void MulMatrix(const S21BasicMatrixBatch& other);
+  S21BasicMatrixBatch Transpose() const;
+  // определители всех матриц
+  std::vector<double> Determinant() const;
+  S21BasicMatrixBatch InverseMatrix() const;
+
+  bool operator==(const S21BasicMatrixBatch& other) const;
+
+ private:
+  /**
+   * @brief Распределитель с выравниванием буфера на строку кэша.
+   */
+  template <typename U>
+  struct AlignedAllocator {
+    using value_type = U;
+    AlignedAllocator() = default;
+    template <typename V>
+    AlignedAllocator(const AlignedAllocator<V>&) {}
+    U* allocate(std::size_t n) {
+      return static_cast<U*>(
+          ::operator new(n * sizeof(U), std::align_val_t(64)));
+    }
+    void deallocate(U* ptr, std::size_t) {
+      ::operator delete(ptr, std::align_val_t(64));
+    }
+    // resize без аргументов не обнуляет элементы: буферы результатов
+    // операций всё равно целиком перезаписываются
+    template <typename V>
+    void construct(V* ptr) {
+      ::new (static_cast<void*>(ptr)) V;
+    }
+    template <typename V, typename... Args>
+    void construct(V* ptr, Args&&... args) {
+      ::new (static_cast<void*>(ptr)) V(std::forward<Args>(args)...);
+    }
+    bool operator==(const AlignedAllocator&) const { return true; }
+    bool operator!=(const AlignedAllocator&) const { return false; }
+  };
+
+  // пакет с неинициализированными матрицами под результат операции
+  struct Uninitialized {};
+  S21BasicMatrixBatch(int count, int rows, int cols, Uninitialized);
+
+  int Blocks() const { return (count_ + kLanes - 1) / kLanes; }
+  // элементов в одном блоке
+  std::size_t BlockSize() const {
+    return static_cast<std::size_t>(rows_) * cols_ * kLanes;
+  }
+  std::size_t Offset(int index, int i, int j) const {
+    return static_cast<std::size_t>(index / kLanes) * BlockSize() +
+           (static_cast<std::size_t>(i) * cols_ + j) * kLanes + index % kLanes;
+  }
+  // матрицы-заполнители в последнем блоке делает единичными, чтобы
+  // обращение не считало их вырожденными
+  void FillPadding();
+
+  int count_, rows_, cols_;
+  std::vector<T, AlignedAllocator<T>> data_;
+};
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+using S21MatrixBatchF = S21BasicMatrixBatch<float>;
+using S21MatrixBatchI = S21BasicMatrixBatch<int>;
+
+#endif  // S21_MATRIX_BATCH_H
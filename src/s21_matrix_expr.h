@@ -0,0 +1,208 @@
+/**
+ * @file s21_matrix_expr.h
+ * @brief Шаблоны выражений для ленивого поэлементного вычисления.
+ *
+ * Операторы +, - и умножение на число возвращают лёгкие узлы выражения,
+ * а не готовые матрицы. Цепочка вида a + b - c * 2 вычисляется одним
+ * проходом без промежуточных матриц, когда выражение присваивается
+ * S21Matrix (конструктором, operator= или +=/-=).
+ *
+ * Листья (S21Matrix) хранятся в узлах по ссылке, вложенные узлы - по
+ * значению. Поэтому выражение нужно вычислить в пределах полного
+ * выражения, в котором живут его операнды: сохранять его в auto-переменную
+ * нельзя.
+ */
+
+#ifndef S21_MATRIX_EXPR_H
+#define S21_MATRIX_EXPR_H
+
+#include <functional>
+#include <stdexcept>
+#include <type_traits>
+
+template <typename T>
+class S21BasicMatrix;
+
+/**
+ * @class S21MatrixExpr
+ * @brief CRTP-база всех матричных выражений.
+ *
+ * Наследник E предоставляет тип элемента value_type, GetRows(), GetCols(),
+ * At(i, j) - значение элемента выражения - и Overlaps(begin, end): true,
+ * если элемент (i, j) может зависеть от памяти [begin, end) в другой
+ * позиции, чем (i, j), и выражение нельзя вычислять поверх этой памяти.
+ */
+template <typename E>
+class S21MatrixExpr {
+ public:
+  const E& Self() const { return static_cast<const E&>(*this); }
+};
+
+/**
+ * @brief Способ хранения операнда внутри узла: узлы - по значению.
+ */
+template <typename E>
+struct S21MatrixExprOperand {
+  using Type = const E;
+};
+
+/**
+ * @brief Матрицы хранятся по ссылке, без копирования данных.
+ */
+template <typename T>
+struct S21MatrixExprOperand<S21BasicMatrix<T>> {
+  using Type = const S21BasicMatrix<T>&;
+};
+
+/**
+ * @class S21MatrixSum
+ * @brief Узел lhs + rhs.
+ */
+template <typename L, typename R>
+class S21MatrixSum : public S21MatrixExpr<S21MatrixSum<L, R>> {
+ public:
+  using value_type = decltype(std::declval<typename L::value_type>() +
+                              std::declval<typename R::value_type>());
+
+  S21MatrixSum(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols()) {
+      throw std::invalid_argument(
+          "Matrices must have the same dimensions for addition");
+    }
+  }
+
+  int GetRows() const { return lhs_.GetRows(); }
+  int GetCols() const { return lhs_.GetCols(); }
+  value_type At(int i, int j) const { return lhs_.At(i, j) + rhs_.At(i, j); }
+  bool Overlaps(const void* begin, const void* end) const {
+    return lhs_.Overlaps(begin, end) || rhs_.Overlaps(begin, end);
+  }
+
+  const L& GetLhs() const { return lhs_; }
+  const R& GetRhs() const { return rhs_; }
+
+ private:
+  typename S21MatrixExprOperand<L>::Type lhs_;
+  typename S21MatrixExprOperand<R>::Type rhs_;
+};
+
+/**
+ * @class S21MatrixDifference
+ * @brief Узел lhs - rhs.
+ */
+template <typename L, typename R>
+class S21MatrixDifference : public S21MatrixExpr<S21MatrixDifference<L, R>> {
+ public:
+  using value_type = decltype(std::declval<typename L::value_type>() -
+                              std::declval<typename R::value_type>());
+
+  S21MatrixDifference(const L& lhs, const R& rhs) : lhs_(lhs), rhs_(rhs) {
+    if (lhs.GetRows() != rhs.GetRows() || lhs.GetCols() != rhs.GetCols()) {
+      throw std::invalid_argument(
+          "Matrices must have the same dimensions for subtraction");
+    }
+  }
+
+  int GetRows() const { return lhs_.GetRows(); }
+  int GetCols() const { return lhs_.GetCols(); }
+  value_type At(int i, int j) const { return lhs_.At(i, j) - rhs_.At(i, j); }
+  bool Overlaps(const void* begin, const void* end) const {
+    return lhs_.Overlaps(begin, end) || rhs_.Overlaps(begin, end);
+  }
+
+ private:
+  typename S21MatrixExprOperand<L>::Type lhs_;
+  typename S21MatrixExprOperand<R>::Type rhs_;
+};
+
+/**
+ * @class S21MatrixScaled
+ * @brief Узел expr * num.
+ */
+template <typename E>
+class S21MatrixScaled : public S21MatrixExpr<S21MatrixScaled<E>> {
+ public:
+  // целые умножаются на число в double, вещественные - в своём типе
+  using value_type =
+      std::conditional_t<std::is_floating_point_v<typename E::value_type>,
+                         typename E::value_type, double>;
+
+  S21MatrixScaled(const E& expr, double num)
+      : expr_(expr), num_(static_cast<value_type>(num)) {}
+
+  int GetRows() const { return expr_.GetRows(); }
+  int GetCols() const { return expr_.GetCols(); }
+  value_type At(int i, int j) const { return expr_.At(i, j) * num_; }
+  bool Overlaps(const void* begin, const void* end) const {
+    return expr_.Overlaps(begin, end);
+  }
+
+ private:
+  typename S21MatrixExprOperand<E>::Type expr_;
+  value_type num_;
+};
+
+// --> Операторы, строящие узлы
+
+/**
+ * @brief Ленивое сложение.
+ * @throws std::invalid_argument Если размеры операндов не совпадают.
+ */
+template <typename L, typename R>
+S21MatrixSum<L, R> operator+(const S21MatrixExpr<L>& lhs,
+                             const S21MatrixExpr<R>& rhs) {
+  return S21MatrixSum<L, R>(lhs.Self(), rhs.Self());
+}
+
+/**
+ * @brief Ленивое вычитание.
+ * @throws std::invalid_argument Если размеры операндов не совпадают.
+ */
+template <typename L, typename R>
+S21MatrixDifference<L, R> operator-(const S21MatrixExpr<L>& lhs,
+                                    const S21MatrixExpr<R>& rhs) {
+  return S21MatrixDifference<L, R>(lhs.Self(), rhs.Self());
+}
+
+/**
+ * @brief Ленивое умножение на число справа.
+ */
+template <typename E>
+S21MatrixScaled<E> operator*(const S21MatrixExpr<E>& expr, double num) {
+  return S21MatrixScaled<E>(expr.Self(), num);
+}
+
+/**
+ * @brief Ленивое умножение на число слева.
+ */
+template <typename E>
+S21MatrixScaled<E> operator*(double num, const S21MatrixExpr<E>& expr) {
+  return S21MatrixScaled<E>(expr.Self(), num);
+}
+
+/**
+ * @brief Поэлементное сравнение выражений.
+ *
+ * Сравнение матриц и представлений одного типа выполняют более точные
+ * перегрузки с векторными ядрами.
+ *
+ * @return true, если размеры и все элементы совпадают.
+ */
+template <typename L, typename R>
+bool operator==(const S21MatrixExpr<L>& lhs, const S21MatrixExpr<R>& rhs) {
+  const L& a = lhs.Self();
+  const R& b = rhs.Self();
+  if (a.GetRows() != b.GetRows() || a.GetCols() != b.GetCols()) {
+    return false;
+  }
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < a.GetCols(); ++j) {
+      if (a.At(i, j) != b.At(i, j)) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+#endif  // S21_MATRIX_EXPR_H
@@ -0,0 +1,131 @@
+/**
+ * @file s21_matrix_file.h
+ * @brief Внутренний двоичный формат файлов матриц (Save, Load, MulFiles).
+ *
+ * Файл состоит из заголовка Header (64 байта) и буфера матрицы
+ * rows x stride как есть, со смещения data_offset, кратного 64.
+ */
+
+#ifndef S21_MATRIX_FILE_H
+#define S21_MATRIX_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+namespace s21::file {
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kVersion = 1;
+// записывается в порядке байтов машины; другой порядок при чтении
+// означает файл с машины с иным порядком байтов
+constexpr std::uint32_t kByteOrderMark = 0x01020304;
+constexpr std::uint64_t kDataOffset = 64;
+
+/**
+ * @brief Заголовок файла матрицы (версия 1).
+ */
+struct Header {
+  char magic[8];                   // "S21MATRX"
+  std::uint32_t version;           // kVersion
+  std::uint32_t byte_order;        // kByteOrderMark
+  std::uint32_t element_type;      // ElementType<T>()
+  std::int32_t rows;               // число строк
+  std::int32_t cols;               // число столбцов
+  std::int32_t stride;             // шаг строки в элементах
+  std::uint64_t data_offset;       // начало данных от начала файла
+  std::uint64_t payload_bytes;     // rows * stride * sizeof(T)
+  std::uint64_t payload_checksum;  // Checksum данных
+  std::uint64_t header_checksum;   // Checksum предыдущих полей заголовка
+};
+static_assert(sizeof(Header) == 64);
+
+/**
+ * @brief Код типа элементов в заголовке.
+ */
+template <typename T>
+constexpr std::uint32_t ElementType() {
+  if constexpr (std::is_same_v<T, double>) {
+    return 1;
+  } else if constexpr (std::is_same_v<T, float>) {
+    return 2;
+  } else {
+    static_assert(std::is_same_v<T, int>, "Unsupported element type");
+    return 3;
+  }
+}
+
+/**
+ * @class Checksum
+ * @brief 64-битная контрольная сумма в духе FNV-1a, вычисляемая по частям.
+ *
+ * Данные читаются 8-байтовыми словами в четыре независимые цепочки, чтобы
+ * умножения шли параллельно; сдвиг после умножения переносит старшие биты
+ * в младшие. Результат не зависит от того, какими частями подавались
+ * данные.
+ */
+class Checksum {
+ public:
+  void Update(const void* data, std::size_t bytes);
+  std::uint64_t Digest() const;
+
+  // сумма одного непрерывного буфера
+  static std::uint64_t Of(const void* data, std::size_t bytes);
+
+ private:
+  static constexpr std::size_t kBlock = 32;
+
+  void Block(const unsigned char* block);
+
+  std::uint64_t lanes_[4] = {0xcbf29ce484222325ULL, 0xcbf29ce484222326ULL,
+                             0xcbf29ce484222327ULL, 0xcbf29ce484222328ULL};
+  unsigned char tail_[kBlock] = {};
+  std::size_t tail_size_ = 0;
+  std::uint64_t total_ = 0;
+};
+
+// заголовок с заполненными полями формата; контрольные суммы нулевые
+Header MakeHeader(std::uint32_t element_type, std::size_t element_size,
+                  int rows, int cols, int stride);
+std::uint64_t HeaderChecksum(const Header& header);
+
+/**
+ * @class Descriptor
+ * @brief Дескриптор файла, закрываемый при выходе из области.
+ */
+class Descriptor {
+ public:
+  explicit Descriptor(int fd) : fd_(fd) {}
+  Descriptor(const Descriptor&) = delete;
+  Descriptor& operator=(const Descriptor&) = delete;
+  ~Descriptor();
+
+  int Get() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+// открывает файл на чтение и возвращает его размер в file_size
+// @throws std::runtime_error Если файл не открывается.
+int OpenForReading(const std::string& path, std::uint64_t& file_size);
+
+// читает и проверяет заголовок файла с элементами element_type
+// @throws std::runtime_error Если файл повреждён или другого типа.
+Header ReadHeader(int fd, const std::string& path, std::uint64_t file_size,
+                  std::uint32_t element_type, std::size_t element_size);
+
+// чтение и запись ровно bytes байт со смещения offset; false при ошибке
+bool ReadAt(int fd, void* data, std::size_t bytes, std::uint64_t offset);
+bool WriteAt(int fd, const void* data, std::size_t bytes,
+             std::uint64_t offset);
+
+[[noreturn]] void ThrowCorrupted(const std::string& path);
+
+// имя временного файла, которым атомарно заменяется path
+std::string TemporaryPath(const std::string& path);
+
+}  // namespace s21::file
+
+#endif  // S21_MATRIX_FILE_H
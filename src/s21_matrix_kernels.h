@@ -0,0 +1,266 @@
+/**
+ * @file s21_matrix_kernels.h
+ * @brief Внутренние вычислительные ядра библиотеки S21Matrix.
+ *
+ * Ядра работают с «сырыми» указателями и шагами, не знают о классе S21Matrix
+ * и не бросают исключений: проверки размеров выполняют методы класса.
+ */
+
+#ifndef S21_MATRIX_KERNELS_H
+#define S21_MATRIX_KERNELS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+
+#include "s21_matrix_simd.h"
+
+// Типы элементов, для которых шаблоны библиотеки явно инстанцируются в
+// s21_matrix_oop.a: X(тип) раскрывается для каждого из них
+#define S21_MATRIX_FOR_EACH_TYPE(X) X(double) X(float) X(int)
+// Вещественные типы: для них есть LU-разложение и обращение
+#define S21_MATRIX_FOR_EACH_FLOATING_TYPE(X) X(double) X(float)
+
+namespace s21::kernels {
+
+/**
+ * @brief Константная ссылка на матрицу с произвольными шагами.
+ *
+ * Элемент (i, j) лежит по адресу data[i * row_stride + j * col_stride], что
+ * позволяет одинаково описывать обычную и транспонированную матрицы.
+ */
+template <typename T>
+struct ConstMatrixRef {
+  const T* data;
+  std::ptrdiff_t row_stride;
+  std::ptrdiff_t col_stride;
+
+  inline T At(int i, int j) const {
+    return data[i * row_stride + j * col_stride];
+  }
+};
+
+// Размеры блоков GEMM
+constexpr int kGemmMr = 4;     // строк в регистровом микроядре
+constexpr int kGemmNr = 8;     // столбцов в микроядре для double
+constexpr int kGemmKc = 256;   // панель kc x nr остаётся в L1
+constexpr int kGemmMc = 128;   // упакованный блок mc x kc остаётся в L2
+constexpr int kGemmNc = 2048;  // упакованная панель kc x nc остаётся в L3
+
+// Ниже этого числа умножений-сложений упаковка не окупается
+constexpr long long kGemmSmallVolume = 32 * 32 * 32;
+
+// Параметры многопоточного GEMM: меньшие произведения считаются в одном
+// потоке, большие делятся на kGemmTilesPerThread тайлов C на поток
+constexpr long long kGemmParallelVolume = 128LL * 128 * 128;
+constexpr int kGemmTilesPerThread = 4;
+constexpr int kGemmMinTile = 64;  // минимальная сторона тайла C
+
+// GEMV упирается в чтение A: от этого числа элементов A строки y делятся
+// между потоками пула
+constexpr long long kGemvParallelSize = 512LL * 512;
+
+/**
+ * @brief Параметры GEMM для типа элементов T.
+ *
+ * Целые произведения копятся в long long и приводятся к T только при
+ * записи в C. Строка накопителей микроядра занимает 64 байта: 8 double,
+ * 16 float или 8 long long.
+ */
+template <typename T>
+struct GemmTraits {
+  using Accumulator = std::conditional_t<std::is_integral_v<T>, long long, T>;
+  static constexpr int kNr =
+      static_cast<int>(kGemmNr * sizeof(double) / sizeof(Accumulator));
+};
+
+/**
+ * @brief Вычисляет C = alpha * A * B + beta * C.
+ *
+ * При объёме от kGemmParallelVolume и более чем одном потоке в
+ * S21ThreadPool::Instance() работа делится на двумерные тайлы C. beta
+ * применяется микроядром при первой записи тайла, без отдельного прохода
+ * по C; при beta = 0 исходное содержимое C не читается.
+ * Инстанцирован для типов S21_MATRIX_FOR_EACH_TYPE.
+ *
+ * @param m Число строк A и C.
+ * @param n Число столбцов B и C.
+ * @param k Число столбцов A и строк B.
+ * @param alpha Множитель произведения.
+ * @param a Матрица A (m x k).
+ * @param b Матрица B (k x n).
+ * @param beta Множитель исходного содержимого C.
+ * @param c Указатель на C, строки которой лежат с шагом ldc.
+ * @param ldc Шаг строки C.
+ */
+template <typename T>
+void Gemm(int m, int n, int k, T alpha, ConstMatrixRef<T> a,
+          ConstMatrixRef<T> b, T beta, T* c, std::ptrdiff_t ldc);
+
+/**
+ * @brief Вычисляет y = alpha * A * x + beta * y.
+ *
+ * Строки A с единичным шагом столбца читаются скалярными произведениями
+ * по kNr накопителей, иначе (транспонированная A) полоса y из kNr
+ * элементов копится в регистрах, пока по ней проходят все столбцы A.
+ * Инстанцирован для типов S21_MATRIX_FOR_EACH_TYPE.
+ *
+ * @param m Число строк A и длина y.
+ * @param n Число столбцов A и длина x.
+ * @param alpha Множитель произведения.
+ * @param a Матрица A (m x n).
+ * @param x Вектор x, элементы которого лежат с шагом incx.
+ * @param incx Шаг x.
+ * @param beta Множитель исходного содержимого y.
+ * @param y Вектор y, элементы которого лежат с шагом incy.
+ * @param incy Шаг y.
+ */
+template <typename T>
+void Gemv(int m, int n, T alpha, ConstMatrixRef<T> a, const T* x,
+          std::ptrdiff_t incx, T beta, T* y, std::ptrdiff_t incy);
+
+// Порог Штрассена-Винограда по умолчанию: наибольшая сторона листа
+// рекурсии, который умножается Gemm
+constexpr int kStrassenCrossover = 512;
+
+/**
+ * @brief Возвращает глубину рекурсии Штрассена-Винограда: сколько раз
+ * нужно разделить стороны пополам (с округлением вверх), чтобы
+ * наибольшая стала не больше crossover.
+ */
+int StrassenDepth(int m, int n, int k, int crossover);
+
+/**
+ * @brief Вычисляет C = A * B по схеме Штрассена-Винограда.
+ *
+ * Стороны дополняются нулями до кратных 2^StrassenDepth; дополненные
+ * копии и рабочая память рекурсии (около (m + k) * max(k, n) / 3
+ * элементов) выделяются одним буфером. Инстанцирован для типов
+ * S21_MATRIX_FOR_EACH_FLOATING_TYPE: у целых промежуточные суммы могли бы
+ * переполниться.
+ *
+ * @param crossover Наибольшая сторона листа, см. StrassenDepth.
+ */
+template <typename T>
+void Strassen(int m, int n, int k, ConstMatrixRef<T> a, ConstMatrixRef<T> b,
+              T* c, std::ptrdiff_t ldc, int crossover);
+
+/**
+ * @brief Решает L * X = B на месте B, L - нижнетреугольная n x n.
+ *
+ * B (n x nrhs) лежит построчно с шагом ldb; элементы L над диагональю не
+ * читаются. Большие системы с многими правыми частями делят столбцы B
+ * между потоками S21ThreadPool. Инстанцирован для типов
+ * S21_MATRIX_FOR_EACH_FLOATING_TYPE.
+ *
+ * @param unit_diagonal Диагональ L считается единичной и не читается.
+ */
+template <typename T>
+void SolveLower(int n, int nrhs, ConstMatrixRef<T> l, bool unit_diagonal,
+                T* b, std::ptrdiff_t ldb);
+
+/**
+ * @brief Решает U * X = B на месте B, U - верхнетреугольная n x n.
+ *
+ * Аналог SolveLower; элементы U под диагональю не читаются.
+ */
+template <typename T>
+void SolveUpper(int n, int nrhs, ConstMatrixRef<T> u, bool unit_diagonal,
+                T* b, std::ptrdiff_t ldb);
+
+// Сторона листового блока транспонирования: блок и его образ (2 x 8 КБ)
+// помещаются в L1
+constexpr int kTransposeBlock = 32;
+
+/**
+ * @brief Записывает в dst (cols x rows) транспонированную src (rows x cols).
+ *
+ * Кэш-независимая рекурсия до блоков kTransposeBlock, которые
+ * транспонируются векторным ядром (double) или простым циклом. Области
+ * src и dst не должны пересекаться.
+ *
+ * @param lds Шаг строки src.
+ * @param ldd Шаг строки dst.
+ */
+template <typename T>
+void Transpose(const T* src, std::ptrdiff_t lds, T* dst, std::ptrdiff_t ldd,
+               int rows, int cols);
+
+/**
+ * @brief Транспонирует квадратную матрицу n x n на месте без выделения
+ * памяти в куче.
+ *
+ * @param lda Шаг строки.
+ */
+template <typename T>
+void TransposeSquareInPlace(T* a, std::ptrdiff_t lda, int n);
+
+// --> Поэлементные ядра: для double - таблица s21::simd, для остальных
+// типов - простые циклы, которые векторизует компилятор
+
+// dst[i] += src[i]
+template <typename T>
+inline void Add(T* dst, const T* src, std::size_t n) {
+  if constexpr (std::is_same_v<T, double>) {
+    simd::Active().add(dst, src, n);
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] += src[i];
+    }
+  }
+}
+
+// dst[i] -= src[i]
+template <typename T>
+inline void Sub(T* dst, const T* src, std::size_t n) {
+  if constexpr (std::is_same_v<T, double>) {
+    simd::Active().sub(dst, src, n);
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] -= src[i];
+    }
+  }
+}
+
+// dst[i] = a[i] + b[i]
+template <typename T>
+inline void AddTo(T* dst, const T* a, const T* b, std::size_t n) {
+  if constexpr (std::is_same_v<T, double>) {
+    simd::Active().add_to(dst, a, b, n);
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = a[i] + b[i];
+    }
+  }
+}
+
+// dst[i] *= num; целые умножаются в double и отбрасывают дробную часть
+template <typename T>
+inline void Scale(T* dst, double num, std::size_t n) {
+  if constexpr (std::is_same_v<T, double>) {
+    simd::Active().scale(dst, num, n);
+  } else if constexpr (std::is_floating_point_v<T>) {
+    const T factor = static_cast<T>(num);
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] *= factor;
+    }
+  } else {
+    for (std::size_t i = 0; i < n; ++i) {
+      dst[i] = static_cast<T>(dst[i] * num);
+    }
+  }
+}
+
+// true, если a[i] == b[i] для всех i
+template <typename T>
+inline bool Equal(const T* a, const T* b, std::size_t n) {
+  if constexpr (std::is_same_v<T, double>) {
+    return simd::Active().equal(a, b, n);
+  } else {
+    return std::equal(a, a + n, b);
+  }
+}
+
+}  // namespace s21::kernels
+
+#endif  // S21_MATRIX_KERNELS_H
@@ -1,71 +1,618 @@
 /**
  * @file s21_matrix_oop.h
- * @brief Заголовочный файл для класса S21Matrix, реализующего матричные
- * операции.
+ * @brief Заголовочный файл для шаблона S21BasicMatrix и его псевдонимов
+ * S21Matrix (double), S21MatrixF (float) и S21MatrixI (int), реализующих
+ * матричные операции.
  */
 
 #ifndef S21_MATRIX_OOP_H
 #define S21_MATRIX_OOP_H
 
 #include <cmath>
+#include <cstddef>
+#include <functional>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "s21_matrix_expr.h"
+
+// порог встроенного хранения: матрицы не больше чем из стольких элементов
+// лежат внутри объекта без обращения к куче; задаётся при сборке
+// (-DS21_MATRIX_INLINE_CAPACITY=0 отключает) одинаково для библиотеки и
+// программы, которая её использует
+#ifndef S21_MATRIX_INLINE_CAPACITY
+#define S21_MATRIX_INLINE_CAPACITY 16
+#endif
+
+class S21MatrixAllocator;
+template <typename T>
+class S21BasicMatrixLU;
+template <typename T>
+class S21BasicMatrixCholesky;
+template <typename T>
+class S21BasicMatrixView;
+
+/**
+ * @brief Способ загрузки матрицы из файла, см. S21BasicMatrix::Load.
+ */
+enum class S21MatrixLoadMode {
+  kCopy,        // чтение в собственный буфер
+  kCopyOnWrite  // отображение файла; изменения видны только процессу
+};
+
 /**
- * @class S21Matrix
- * @brief Класс, реализующий матричные операции.
+ * @brief Алгоритм умножения матриц, см. S21BasicMatrix::MulMatrix.
  */
-class S21Matrix {
+enum class S21MatrixMulAlgorithm {
+  kAuto,     // Штрассен-Виноград для квадратных больше порога, иначе kBlocked
+  kBlocked,  // блочный GEMM, O(n^3)
+  kStrassen  // Штрассен-Виноград до листов не больше порога (и не квадратные)
+};
+
+/**
+ * @brief Транспонирование множителя, см. S21BasicMatrix::Gemm.
+ */
+enum class S21MatrixTranspose {
+  kNone,      // множитель как есть
+  kTranspose  // множитель читается транспонированным, без копии
+};
+
+/**
+ * @brief Способ решения системы, см. S21BasicMatrix::Solve.
+ */
+enum class S21MatrixSolver {
+  kAuto,             // по структуре матрицы
+  kLU,               // LU-разложение с частичным выбором
+  kCholesky,         // симметричная положительно определённая
+  kLowerTriangular,  // читаются только диагональ и элементы под ней
+  kUpperTriangular,  // читаются только диагональ и элементы над ней
+  kDiagonal          // читается только диагональ
+};
+
+/**
+ * @class S21BasicMatrix
+ * @brief Класс, реализующий матричные операции над элементами типа T.
+ *
+ * Матрица - лист шаблонов выражений: a + b, a - b и a * 2.0 строят узлы
+ * S21MatrixExpr, которые вычисляются одним проходом при присваивании.
+ *
+ * Малые матрицы (до S21_MATRIX_INLINE_CAPACITY элементов) хранятся во
+ * встроенном буфере объекта: их создание, копирование и перенос не
+ * выделяют память. Большие лежат в куче у текущего распределителя потока.
+ *
+ * Реализация собрана в библиотеке для double (S21Matrix), float
+ * (S21MatrixF) и int (S21MatrixI). Для целых типов произведение копится в
+ * long long, определитель и алгебраические дополнения считаются точно
+ * (алгоритм Барейса), а обращение и LU-разложение недоступны.
+ */
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
  public:
-  S21Matrix();  // стандартный конструктор
-  S21Matrix(int rows, int cols);  // параметризированный конструктор
-  S21Matrix(const S21Matrix& other);  // конструктор копирования
-  S21Matrix(S21Matrix&& other);  // конструктор переноса
-  ~S21Matrix();                  // деструктор
+  using value_type = T;
+
+  S21BasicMatrix();  // стандартный конструктор
+  S21BasicMatrix(int rows, int cols);  // параметризированный конструктор
+  S21BasicMatrix(const S21BasicMatrix& other);  // конструктор копирования
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;  // конструктор переноса
+  ~S21BasicMatrix();                                // деструктор
+
+  // вычисление выражения одним проходом
+  template <typename E>
+  S21BasicMatrix(const S21MatrixExpr<E>& expr);
 
   // методы
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulMatrix(const S21Matrix& other);
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulMatrix(
+      const S21BasicMatrix& other,
+      S21MatrixMulAlgorithm algorithm = S21MatrixMulAlgorithm::kAuto);
+  void MulMatrix(const S21BasicMatrixView<T>& other);
   void MulNumber(const double num);
   void Resize(int rows, int cols);
 
-  S21Matrix Transpose();
-  S21Matrix InverseMatrix();
-  S21Matrix CalcComplements();
-  S21Matrix GetMatrixMinor(int row, int col) const;
+  S21BasicMatrix Transpose() const;
+  // транспонированное представление за O(1); умножение читает его
+  // с переставленными шагами, не создавая копию
+  S21BasicMatrixView<T> TransposeView() const;
+  void TransposeInPlace();  // только для квадратных, без выделения памяти
+  S21BasicMatrix InverseMatrix() const;
+  void InverseMatrixInPlace();  // обращение с записью поверх *this
+  S21BasicMatrix CalcComplements() const;
+  S21BasicMatrix GetMatrixMinor(int row, int col) const;
+
+  // представления без копирования данных
+  S21BasicMatrixView<T> Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView<T> MinorView(int row, int col) const;
+
+  double Determinant() const;
+
+  // двоичный формат: заголовок с размерами, типом, шагом и контрольными
+  // суммами, затем буфер как есть (matrix_io.cpp)
+  void Save(const std::string& path) const;
+  static S21BasicMatrix Load(
+      const std::string& path,
+      S21MatrixLoadMode mode = S21MatrixLoadMode::kCopyOnWrite,
+      bool verify = false);
+  // отображение файла только для чтения: представление (и его блоки)
+  // владеет отображением, страницы защищены от записи
+  static S21BasicMatrixView<T> LoadView(const std::string& path,
+                                        bool verify = false);
+
+  // память под тайлы MulFiles по умолчанию, 1 ГБ
+  static constexpr std::size_t kDefaultMemoryBudget = std::size_t{1} << 30;
+  // c_path = a_path * b_path для файлов Save, не загружая матрицы целиком:
+  // тайлы читаются и пишутся по частям (matrix_out_of_core.cpp)
+  static void MulFiles(const std::string& a_path, const std::string& b_path,
+                       const std::string& c_path,
+                       std::size_t memory_budget = kDefaultMemoryBudget);
+
+  // порог Штрассена-Винограда: наибольшая сторона листа рекурсии, общий
+  // для всех потоков (matrix_strassen.cpp); целые всегда умножаются kBlocked
+  static int GetStrassenCrossover();
+  static void SetStrassenCrossover(int crossover);
+
+  // C = alpha * op(A) * op(B) + beta * C в уже созданную C без
+  // промежуточных матриц (matrix_blas.cpp)
+  static void Gemm(T alpha, const S21BasicMatrix& a, const S21BasicMatrix& b,
+                   T beta, S21BasicMatrix& c,
+                   S21MatrixTranspose trans_a = S21MatrixTranspose::kNone,
+                   S21MatrixTranspose trans_b = S21MatrixTranspose::kNone);
+  // y = alpha * op(A) * x + beta * y; x и y - строки или столбцы
+  static void Gemv(T alpha, const S21BasicMatrix& a, const S21BasicMatrix& x,
+                   T beta, S21BasicMatrix& y,
+                   S21MatrixTranspose trans_a = S21MatrixTranspose::kNone);
 
-  double Determinant();
+  // LU-разложение с частичным выбором (только вещественные типы)
+  S21BasicMatrixLU<T> LU() const { return S21BasicMatrixLU<T>(*this); }
+  // разложение Холецкого A = L * L^T (только вещественные типы)
+  S21BasicMatrixCholesky<T> Cholesky() const {
+    return S21BasicMatrixCholesky<T>(*this);
+  }
+  // решение A * X = B для всех столбцов B сразу (matrix_solve.cpp)
+  S21BasicMatrix Solve(const S21BasicMatrix& b,
+                       S21MatrixSolver solver = S21MatrixSolver::kAuto) const;
   // Методы-аксессоры/геттеры
   int GetRows() const;
   int GetCols() const;
 
+  // шаг между соседними строками в буфере (в элементах)
+  int GetStride() const;
+
   // Методы-мутаторы/сеттеры
-  inline void SetRows(int rows) { rows_ = rows; }
-  inline void SetCols(int cols) { cols_ = cols; }
-
-  // перегрузка операторов
-  S21Matrix operator+(const S21Matrix& other);
-  S21Matrix& operator+=(const S21Matrix& other);
-  S21Matrix operator-(const S21Matrix& other);
-  S21Matrix& operator-=(const S21Matrix& other);
-  S21Matrix operator*(const S21Matrix& other);
-  S21Matrix& operator*=(const S21Matrix& other);
-  S21Matrix& operator=(const S21Matrix& other);
+  inline void SetRows(int rows) { Resize(rows, cols_); }
+  inline void SetCols(int cols) { Resize(rows_, cols); }
+
+  // прямой доступ к непрерывному буферу для горячих циклов
+  inline T* data() noexcept { return matrix_; }
+  inline const T* data() const noexcept { return matrix_; }
+  inline T* row(int i) noexcept {
+    return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+  inline const T* row(int i) const noexcept {
+    return matrix_ + static_cast<std::ptrdiff_t>(i) * stride_;
+  }
+
+  // перегрузка операторов (+, - и умножение на число - в s21_matrix_expr.h)
+  S21BasicMatrix& operator+=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& other);
+  S21BasicMatrix operator*(const S21BasicMatrix& other) const;
+  S21BasicMatrix& operator*=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator*=(const S21BasicMatrixView<T>& other);
+  S21BasicMatrix& operator=(const S21BasicMatrix& other);
+  S21BasicMatrix& operator=(S21BasicMatrix&& other) noexcept;
+
+  template <typename E>
+  S21BasicMatrix& operator=(const S21MatrixExpr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator+=(const S21MatrixExpr<E>& expr);
+  template <typename E>
+  S21BasicMatrix& operator-=(const S21MatrixExpr<E>& expr);
 
   // перегрузка оператора сравнения
-  bool operator==(const S21Matrix& other) const;
+  bool operator==(const S21BasicMatrix& other) const;
 
   // перегрузка операторов индексации
-  double& operator()(int i, int j);
-  double& operator()(int i, int j) const;
+  inline T& operator()(int i, int j) { return row(i)[j]; }
+  inline T& operator()(int i, int j) const {
+    return const_cast<T&>(row(i)[j]);
+  }
 
-  // перегрузка оператора вывода
-  friend std::ostream& operator<<(std::ostream& os, const S21Matrix& matrix);
+  // элемент как значение листа выражения
+  inline T At(int i, int j) const { return row(i)[j]; }
+  // матрица читается в той же позиции, где пишется результат, а чужой
+  // буфер не может пересекаться с буфером приёмника
+  inline bool Overlaps(const void*, const void*) const { return false; }
 
  private:
+  // выравнивание буфера в байтах (кэш-линия)
+  static constexpr std::size_t kAlignment = 64;
+  // строки выравниваются до кратного числа элементов (32 байта, AVX)
+  static constexpr int kStrideAlign = 32 / sizeof(T);
+  // ёмкость встроенного буфера в элементах
+  static constexpr int kInlineCapacity = S21_MATRIX_INLINE_CAPACITY;
+  static_assert(kInlineCapacity >= 0, "Inline capacity must be non-negative");
+
+  static int CalcStride(int cols);
+  // помещается ли матрица rows x cols во встроенный буфер
+  static bool FitsInline(int rows, int cols);
+
+  inline bool IsInline() const noexcept { return matrix_ == inline_; }
+  // освобождает буфер в куче, если он есть
+  void Release() noexcept;
+  // забирает содержимое other (буфер в куче или копию встроенного),
+  // оставляя other пустой; текущий буфер должен быть освобождён
+  void Steal(S21BasicMatrix& other) noexcept;
+
+  // число элементов буфера вместе с заполнением строк
+  inline std::size_t BufferSize() const {
+    return static_cast<std::size_t>(rows_) * stride_;
+  }
+  // число элементов без заполнения, для счётчиков S21MatrixStats
+  inline unsigned long long Elements() const {
+    return static_cast<unsigned long long>(rows_) * cols_;
+  }
+
+  // присваивает expr на месте или через новый буфер, см. operator=
+  template <typename E>
+  void Assign(const E& expr);
+  // записывает expr в *this того же размера; expr не должен читать
+  // буфер *this в других позициях (Overlaps)
+  template <typename E>
+  void Evaluate(const E& expr);
+  // *this = a + b векторизованным ядром
+  void EvaluateSum(const S21BasicMatrix& a, const S21BasicMatrix& b);
+  // копия представления построчно или блочным транспонированием
+  void EvaluateView(const S21BasicMatrixView<T>& view);
+
+  // произведение a * b в новую матрицу
+  static S21BasicMatrix Multiply(
+      const S21BasicMatrix& a, const S21BasicMatrix& b,
+      S21MatrixMulAlgorithm algorithm = S21MatrixMulAlgorithm::kAuto);
+  // c = alpha * op(a) * op(b) + beta * c без проверок размеров и
+  // пересечения c с множителями; Штрассен выбирается по algorithm
+  static void MultiplyInto(T alpha, const S21BasicMatrix& a,
+                           S21MatrixTranspose trans_a, const S21BasicMatrix& b,
+                           S21MatrixTranspose trans_b, T beta,
+                           S21BasicMatrix& c, S21MatrixMulAlgorithm algorithm);
+
+  // матрица алгебраических дополнений через LU-разложение, O(n^3)
+  S21BasicMatrix ComplementsByFactorization() const;
+  // заголовок перед данными буфера, см. Allocate
+  struct BlockHeader {
+    S21MatrixAllocator* allocator;
+    std::size_t bytes;
+  };
+  static_assert(sizeof(BlockHeader) <= kAlignment);
+
+  static T* Allocate(std::size_t count);
+  static void Deallocate(T* ptr) noexcept;
+
   int rows_, cols_;
-  std::vector<std::vector<double>> matrix_;
+  int stride_;
+  // единый выровненный буфер rows_ x stride_ в построчном порядке:
+  // inline_ у малых матриц или блок в куче у остальных
+  T* matrix_;
+  // встроенный буфер; у матриц в нём шаг строки равен числу столбцов
+  alignas(kAlignment) T inline_[kInlineCapacity > 0 ? kInlineCapacity : 1];
+};
+
+/**
+ * @class S21BasicMatrixLU
+ * @brief Результат LU-разложения P * A = L * U с частичным выбором ведущего
+ * элемента.
+ *
+ * L (с единичной диагональю) и U хранятся упакованными в одной матрице:
+ * под диагональю лежат множители L, на диагонали и выше - U. Разложение
+ * вычисляется один раз и может переиспользоваться несколькими операциями.
+ */
+template <typename T>
+class S21BasicMatrixLU {
+  static_assert(std::is_floating_point_v<T>,
+                "LU decomposition requires a floating-point element type");
+
+ public:
+  explicit S21BasicMatrixLU(const S21BasicMatrix<T>& matrix);
+  // разложение в буфере переданной временной матрицы
+  explicit S21BasicMatrixLU(S21BasicMatrix<T>&& matrix);
+
+  // упакованные множители L и U
+  const S21BasicMatrix<T>& GetLU() const { return lu_; }
+  // pivots[k] - строка, переставленная со строкой k на шаге k
+  const std::vector<int>& GetPivots() const { return pivots_; }
+  // знак перестановки P (+1 или -1)
+  int GetSign() const { return sign_; }
+  int GetSize() const { return lu_.GetRows(); }
+
+  double PivotRatio() const;
+  bool IsSingular() const;
+  double Determinant() const;
+  // решение A * X = B для новой правой части без повторного разложения
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+
+ private:
+  S21BasicMatrix<T> lu_;
+  std::vector<int> pivots_;
+  int sign_;
 };
 
+/**
+ * @class S21BasicMatrixCholesky
+ * @brief Результат разложения Холецкого A = L * L^T симметричной
+ * положительно определённой матрицы.
+ *
+ * Читается только нижний треугольник A. Разложение вдвое дешевле LU и не
+ * переставляет строки; если матрица не положительно определённая,
+ * IsPositiveDefinite() возвращает false, а Solve бросает исключение.
+ */
+template <typename T>
+class S21BasicMatrixCholesky {
+  static_assert(std::is_floating_point_v<T>,
+                "Cholesky decomposition requires a floating-point element "
+                "type");
+
+ public:
+  explicit S21BasicMatrixCholesky(const S21BasicMatrix<T>& matrix);
+
+  // нижнетреугольный множитель L (над диагональю нули)
+  const S21BasicMatrix<T>& GetL() const { return l_; }
+  int GetSize() const { return l_.GetRows(); }
+  bool IsPositiveDefinite() const { return positive_definite_; }
+
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+
+ private:
+  S21BasicMatrix<T> l_;
+  bool positive_definite_;
+};
+
+/**
+ * @class S21BasicMatrixView
+ * @brief Невладеющее представление прямоугольного блока матрицы.
+ *
+ * Описывается указателем на левый верхний элемент, размерами, шагами строки
+ * и столбца и необязательными пропущенными строкой и столбцом (для
+ * миноров). Элемент (i, j) лежит в строке i + (i >= skip_row) и столбце
+ * j + (j >= skip_col) исходного буфера. Транспонирование представления
+ * меняет местами шаги и стоит O(1). Представление остаётся действительным,
+ * пока исходная матрица существует и не меняет размер. Исключение -
+ * представление S21BasicMatrix::LoadView: оно, как и полученные из него
+ * блоки и транспонирования, совместно владеет отображением файла.
+ *
+ * Представление - лист шаблонов выражений, поэтому участвует в +, - и
+ * умножении на число наравне с матрицей; S21Matrix(view) копирует его.
+ */
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+ public:
+  using value_type = T;
+
+  S21BasicMatrixView(const S21BasicMatrix<T>& matrix);  // вся матрица
+  // построчный буфер с шагом строки stride
+  S21BasicMatrixView(const T* data, int rows, int cols, std::ptrdiff_t stride,
+                     int skip_row = -1, int skip_col = -1);
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  // шаги между соседними строками и столбцами (в элементах)
+  std::ptrdiff_t GetRowStride() const { return row_stride_; }
+  std::ptrdiff_t GetColStride() const { return col_stride_; }
+  // пропущенные строка и столбец или -1
+  int GetSkipRow() const { return skip_row_ == kNoSkip ? -1 : skip_row_; }
+  int GetSkipCol() const { return skip_col_ == kNoSkip ? -1 : skip_col_; }
+  // левый верхний элемент в исходном буфере
+  const T* data() const noexcept { return data_; }
+  // строки лежат подряд (шаг столбца 1, пропуска столбца нет)
+  bool IsRowContiguous() const {
+    return col_stride_ == 1 && skip_col_ == kNoSkip;
+  }
+
+  // индексы в исходном буфере относительно data()
+  inline int SourceRow(int i) const { return i + (i >= skip_row_); }
+  inline int SourceCol(int j) const { return j + (j >= skip_col_); }
+
+  inline const T* Address(int i, int j) const {
+    return data_ + SourceRow(i) * row_stride_ + SourceCol(j) * col_stride_;
+  }
+  inline T At(int i, int j) const { return *Address(i, j); }
+  inline T operator()(int i, int j) const { return At(i, j); }
+  // консервативно: любое пересечение с [begin, end)
+  inline bool Overlaps(const void* begin, const void* end) const {
+    const std::less<const void*> less;
+    return rows_ > 0 && cols_ > 0 && less(data_, end) &&
+           !less(Address(rows_ - 1, cols_ - 1), begin);
+  }
+
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView Transposed() const;  // O(1), без копирования
+  double Determinant() const;
+
+ private:
+  static constexpr int kNoSkip = std::numeric_limits<int>::max();
+
+  // задаёт owner_ отображения в LoadView
+  friend class S21BasicMatrix<T>;
+
+  const T* data_;
+  int rows_, cols_;
+  std::ptrdiff_t row_stride_, col_stride_;
+  int skip_row_, skip_col_;
+  // владелец буфера у представлений LoadView, иначе пустой
+  std::shared_ptr<const void> owner_;
+};
+
+// --> Типы элементов, собранные в библиотеке
+
+using S21Matrix = S21BasicMatrix<double>;
+using S21MatrixF = S21BasicMatrix<float>;
+using S21MatrixI = S21BasicMatrix<int>;
+
+using S21MatrixView = S21BasicMatrixView<double>;
+using S21MatrixLU = S21BasicMatrixLU<double>;
+using S21MatrixCholesky = S21BasicMatrixCholesky<double>;
+
+// перегрузка оператора вывода
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const S21BasicMatrix<T>& matrix);
+
+// --> Операции над представлениями
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& lhs,
+                            const S21BasicMatrixView<T>& rhs);
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& lhs,
+                            const S21BasicMatrixView<T>& rhs);
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& lhs,
+                            const S21BasicMatrix<T>& rhs);
+template <typename T>
+bool operator==(const S21BasicMatrixView<T>& lhs,
+                const S21BasicMatrixView<T>& rhs);
+template <typename T>
+bool operator==(const S21BasicMatrix<T>& lhs,
+                const S21BasicMatrixView<T>& rhs);
+template <typename T>
+bool operator==(const S21BasicMatrixView<T>& lhs,
+                const S21BasicMatrix<T>& rhs);
+template <typename T>
+std::ostream& operator<<(std::ostream& os, const S21BasicMatrixView<T>& view);
+
+// --> Операторы для временных матриц: результат пишется в буфер rvalue
+
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs, S21BasicMatrix<T>&& rhs);
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs, S21BasicMatrix<T>&& rhs);
+template <typename T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T>&& matrix, double num);
+template <typename T>
+S21BasicMatrix<T> operator*(double num, S21BasicMatrix<T>&& matrix);
+
+/**
+ * @brief Сложение с временной матрицей без нового буфера.
+ * @throws std::invalid_argument Если размеры не совпадают.
+ */
+template <typename T, typename E>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& lhs,
+                            const S21MatrixExpr<E>& rhs) {
+  lhs += rhs.Self();
+  return std::move(lhs);
+}
+
+template <typename T, typename E>
+S21BasicMatrix<T> operator+(const S21MatrixExpr<E>& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  rhs += lhs.Self();
+  return std::move(rhs);
+}
+
+/**
+ * @brief Вычитание с временной матрицей без нового буфера.
+ * @throws std::invalid_argument Если размеры не совпадают.
+ */
+template <typename T, typename E>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& lhs,
+                            const S21MatrixExpr<E>& rhs) {
+  lhs -= rhs.Self();
+  return std::move(lhs);
+}
+
+template <typename T, typename E>
+S21BasicMatrix<T> operator-(const S21MatrixExpr<E>& lhs,
+                            S21BasicMatrix<T>&& rhs) {
+  rhs = lhs.Self() - rhs;
+  return std::move(rhs);
+}
+
+// --> Вычисление шаблонов выражений
+
+/**
+ * @brief Создаёт матрицу из выражения, вычисляя его одним проходом.
+ *
+ * Элементы приводятся к T, поэтому выражение может смешивать типы.
+ *
+ * @param expr Выражение из матриц, сложений, вычитаний и умножений на число.
+ */
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E>& expr)
+    : S21BasicMatrix(expr.Self().GetRows(), expr.Self().GetCols()) {
+  Evaluate(expr.Self());
+}
+
+/**
+ * @brief Присваивает матрице значение выражения.
+ *
+ * Буфер переиспользуется, если размеры совпадают и выражение не читает
+ * его в других позициях (например, через транспонированное представление
+ * *this); иначе выражение вычисляется в новый буфер.
+ *
+ * @param expr Выражение.
+ * @return Текущая матрица с новыми значениями.
+ */
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21MatrixExpr<E>& expr) {
+  Assign(expr.Self());
+  return *this;
+}
+
+/**
+ * @brief Прибавляет выражение без промежуточной матрицы.
+ * @throws std::invalid_argument Если размеры не совпадают.
+ */
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(
+    const S21MatrixExpr<E>& expr) {
+  Assign(*this + expr);
+  return *this;
+}
+
+/**
+ * @brief Вычитает выражение без промежуточной матрицы.
+ * @throws std::invalid_argument Если размеры не совпадают.
+ */
+template <typename T>
+template <typename E>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(
+    const S21MatrixExpr<E>& expr) {
+  Assign(*this - expr);
+  return *this;
+}
+
+template <typename T>
+template <typename E>
+void S21BasicMatrix<T>::Assign(const E& expr) {
+  if (expr.GetRows() == rows_ && expr.GetCols() == cols_ &&
+      !expr.Overlaps(matrix_, matrix_ + BufferSize())) {
+    Evaluate(expr);
+  } else {
+    *this = S21BasicMatrix(expr);
+  }
+}
+
+template <typename T>
+template <typename E>
+void S21BasicMatrix<T>::Evaluate(const E& expr) {
+  if constexpr (std::is_same_v<E,
+                               S21MatrixSum<S21BasicMatrix, S21BasicMatrix>>) {
+    EvaluateSum(expr.GetLhs(), expr.GetRhs());
+  } else if constexpr (std::is_same_v<E, S21BasicMatrixView<T>>) {
+    EvaluateView(expr);
+  } else {
+    for (int i = 0; i < rows_; ++i) {
+      T* dst = row(i);
+      for (int j = 0; j < cols_; ++j) {
+        dst[j] = static_cast<T>(expr.At(i, j));
+      }
+    }
+  }
+}
+
 #endif  // S21_MATRIX_OOP_H
\ No newline at end of file
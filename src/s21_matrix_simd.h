@@ -0,0 +1,68 @@
+/**
+ * @file s21_matrix_simd.h
+ * @brief Векторизованные поэлементные ядра с выбором набора инструкций во
+ * время выполнения.
+ *
+ * Библиотека собирается без флагов -mavx2/-mavx512f: варианты ядер для
+ * SSE2, AVX2 и AVX-512 компилируются атрибутами target, а подходящий
+ * выбирается один раз по CPUID. Поэтому один и тот же s21_matrix_oop.a
+ * работает на любых x86-64 узлах, используя лучшее доступное расширение.
+ */
+
+#ifndef S21_MATRIX_SIMD_H
+#define S21_MATRIX_SIMD_H
+
+#include <cstddef>
+
+namespace s21::simd {
+
+/**
+ * @brief Набор инструкций, которым выполняются ядра.
+ */
+enum class Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+/**
+ * @brief Таблица ядер для одного набора инструкций.
+ */
+struct Kernels {
+  Isa isa;
+  // dst[i] += src[i]
+  void (*add)(double* dst, const double* src, std::size_t n);
+  // dst[i] -= src[i]
+  void (*sub)(double* dst, const double* src, std::size_t n);
+  // dst[i] = a[i] + b[i]
+  void (*add_to)(double* dst, const double* a, const double* b,
+                 std::size_t n);
+  // dst[i] *= num
+  void (*scale)(double* dst, double num, std::size_t n);
+  // true, если a[i] == b[i] для всех i
+  bool (*equal)(const double* a, const double* b, std::size_t n);
+  // dst (cols x rows, шаг ldd) = src^T (rows x cols, шаг lds)
+  void (*transpose)(const double* src, std::ptrdiff_t lds, double* dst,
+                    std::ptrdiff_t ldd, int rows, int cols);
+};
+
+// Активная таблица ядер
+const Kernels& Active();
+
+// Набор инструкций активной таблицы и его имя ("scalar", "sse2", ...)
+Isa ActiveIsa();
+const char* IsaName(Isa isa);
+
+// Лучший набор, поддерживаемый процессором
+Isa DetectIsa();
+
+/**
+ * @brief Принудительно выбирает набор инструкций.
+ *
+ * Запрос понижается до лучшего поддерживаемого процессором набора. Тот же
+ * выбор при старте делает переменная окружения S21_MATRIX_ISA
+ * (scalar, sse2, avx2, avx512).
+ *
+ * @return Фактически выбранный набор.
+ */
+Isa SetIsa(Isa isa);
+
+}  // namespace s21::simd
+
+#endif  // S21_MATRIX_SIMD_H
@@ -0,0 +1,130 @@
+/**
+ * @file s21_matrix_stats.h
+ * @brief Счётчики горячих операций S21BasicMatrix: вызовы, время,
+ * гистограмма задержек, FLOP, байты и выделения памяти.
+ *
+ * Учёт включается при сборке флагом -DS21_MATRIX_STATS=1 (make STATS=1).
+ * По умолчанию макросы S21_MATRIX_STATS_SCOPE и S21_MATRIX_STATS_ALLOCATION
+ * раскрываются в пустые выражения, их аргументы не вычисляются, и
+ * операции не платят за учёт ничего. Интерфейс снимков доступен в обоих
+ * случаях; без учёта снимки нулевые.
+ */
+
+#ifndef S21_MATRIX_STATS_H
+#define S21_MATRIX_STATS_H
+
+#include <chrono>
+#include <string>
+
+#ifndef S21_MATRIX_STATS
+#define S21_MATRIX_STATS 0
+#endif
+
+/**
+ * @brief Учитываемые операции.
+ */
+enum class S21MatrixOp {
+  kSumMatrix,
+  kSubMatrix,
+  kMulMatrix,  // MulMatrix и operator* двух матриц
+  kGemm,       // S21BasicMatrix::Gemm
+  kGemv,       // S21BasicMatrix::Gemv
+  kMulNumber,
+  kTranspose,
+  kDeterminant,
+  kInverseMatrix,
+  kCalcComplements,
+  kGetMatrixMinor,
+  kCopyConstructor,
+  kCopyAssignment,
+  kCount
+};
+
+/**
+ * @brief Накопленные счётчики одной операции.
+ *
+ * FLOP и байты - номинальные: число арифметических операций алгоритма и
+ * минимальный объём чтения и записи для размеров аргументов.
+ */
+struct S21MatrixOpStats {
+  // latency[i] - вызовы длительностью от 2^i до 2^(i + 1) нс; в нулевую
+  // корзину попадают и более короткие, в последнюю - все более длинные
+  static constexpr int kLatencyBuckets = 32;
+
+  unsigned long long calls;
+  unsigned long long total_ns;
+  unsigned long long flops;
+  unsigned long long bytes;
+  unsigned long long allocations;  // буферов матриц, выделенных в вызове
+  unsigned long long latency[kLatencyBuckets];
+
+  double MeanNs() const;
+};
+
+/**
+ * @brief Снимок счётчиков всех операций.
+ */
+struct S21MatrixStatsSnapshot {
+  S21MatrixOpStats ops[static_cast<int>(S21MatrixOp::kCount)];
+
+  const S21MatrixOpStats& operator[](S21MatrixOp op) const {
+    return ops[static_cast<int>(op)];
+  }
+  // JSON-объект {"enabled": ..., "operations": {"MulMatrix": {...}, ...}}
+  std::string ToJson() const;
+};
+
+/**
+ * @class S21MatrixStats
+ * @brief Глобальные счётчики операций (общие для всех потоков).
+ *
+ * Время вложенных учитываемых вызовов входит и в вызывающую операцию:
+ * например, InverseMatrix включает своё копирование, учтённое также как
+ * kCopyConstructor.
+ */
+class S21MatrixStats {
+ public:
+  static constexpr bool kEnabled = S21_MATRIX_STATS != 0;
+
+  static S21MatrixStatsSnapshot Snapshot();
+  static void Reset();
+  static const char* OpName(S21MatrixOp op);
+
+  // для S21_MATRIX_STATS_SCOPE и S21_MATRIX_STATS_ALLOCATION
+  static void Record(S21MatrixOp op, unsigned long long ns,
+                     unsigned long long flops, unsigned long long bytes,
+                     unsigned long long allocations);
+  static void CountAllocation();
+  static unsigned long long ThreadAllocations();
+};
+
+/**
+ * @class S21MatrixStatsScope
+ * @brief Учитывает вызов операции от создания до конца области.
+ */
+class S21MatrixStatsScope {
+ public:
+  S21MatrixStatsScope(S21MatrixOp op, unsigned long long flops,
+                      unsigned long long bytes);
+  ~S21MatrixStatsScope();
+  S21MatrixStatsScope(const S21MatrixStatsScope&) = delete;
+  S21MatrixStatsScope& operator=(const S21MatrixStatsScope&) = delete;
+
+ private:
+  S21MatrixOp op_;
+  unsigned long long flops_;
+  unsigned long long bytes_;
+  unsigned long long allocations_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+#if S21_MATRIX_STATS
+#define S21_MATRIX_STATS_SCOPE(op, flops, bytes) \
+  const S21MatrixStatsScope s21_matrix_stats_scope((op), (flops), (bytes))
+#define S21_MATRIX_STATS_ALLOCATION() S21MatrixStats::CountAllocation()
+#else
+#define S21_MATRIX_STATS_SCOPE(op, flops, bytes) static_cast<void>(0)
+#define S21_MATRIX_STATS_ALLOCATION() static_cast<void>(0)
+#endif
+
+#endif  // S21_MATRIX_STATS_H
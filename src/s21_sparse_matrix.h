@@ -0,0 +1,136 @@
+/**
+ * @file s21_sparse_matrix.h
+ * @brief Разреженные матрицы в форматах CSR и CSC, совместимые с
+ * S21BasicMatrix.
+ *
+ * Хранятся только ненулевые элементы: массив смещений по внешнему измерению
+ * (строкам в CSR, столбцам в CSC), индексы по внутреннему измерению и
+ * значения. Память и время операций растут с числом ненулевых элементов
+ * nnz, а не с rows x cols. Плотная матрица нужна только на границе:
+ * при преобразовании в разреженную, обратно и как второй множитель SpMM.
+ */
+
+#ifndef S21_SPARSE_MATRIX_H
+#define S21_SPARSE_MATRIX_H
+
+#include <iostream>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+/**
+ * @brief Формат хранения разреженной матрицы.
+ */
+enum class S21SparseFormat {
+  kCsr,  // построчно: смещения по строкам, индексы столбцов
+  kCsc   // по столбцам: смещения по столбцам, индексы строк
+};
+
+/**
+ * @class S21BasicSparseMatrix
+ * @brief Разреженная матрица с элементами типа T.
+ *
+ * Внутри каждой строки (CSR) или столбца (CSC) индексы строго возрастают,
+ * явных нулей нет. Транспонирование меняет формат и не переставляет
+ * элементы; переход между форматами стоит O(nnz + rows + cols).
+ *
+ * Инстанцирован для типов S21_MATRIX_FOR_EACH_TYPE; как и в GEMM, целые
+ * произведения копятся в long long.
+ */
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  using value_type = T;
+
+  // ненулевой элемент для FromTriplets
+  struct Triplet {
+    int row;
+    int col;
+    T value;
+  };
+
+  // доля ненулевых элементов, ниже которой разреженный формат выгоднее
+  static constexpr double kDefaultThreshold = 0.1;
+
+  S21BasicSparseMatrix();  // пустая матрица 0x0
+  // нулевая матрица rows x cols
+  S21BasicSparseMatrix(int rows, int cols,
+                       S21SparseFormat format = S21SparseFormat::kCsr);
+  // из плотной; элементы с модулем не больше tolerance отбрасываются
+  explicit S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                S21SparseFormat format = S21SparseFormat::kCsr,
+                                double tolerance = 0.0);
+
+  static S21BasicSparseMatrix FromTriplets(
+      int rows, int cols, const std::vector<Triplet>& triplets,
+      S21SparseFormat format = S21SparseFormat::kCsr);
+
+  // доля ненулевых элементов плотной матрицы
+  static double Density(const S21BasicMatrix<T>& dense);
+  // true, если ненулевых не больше threshold * rows * cols; просмотр
+  // прекращается, как только порог превышен
+  static bool IsSparse(const S21BasicMatrix<T>& dense,
+                       double threshold = kDefaultThreshold);
+  // a * b, где a переводится в CSR, если IsSparse(a, threshold)
+  static S21BasicMatrix<T> MulAuto(const S21BasicMatrix<T>& a,
+                                   const S21BasicMatrix<T>& b,
+                                   double threshold = kDefaultThreshold);
+
+  S21BasicMatrix<T> ToDense() const;
+  S21BasicSparseMatrix ToCsr() const;
+  S21BasicSparseMatrix ToCsc() const;
+  S21BasicSparseMatrix ToFormat(S21SparseFormat format) const;
+  // A^T за O(nnz) без перестановки: CSR матрицы A - это CSC матрицы A^T
+  S21BasicSparseMatrix Transpose() const;
+
+  int GetRows() const { return rows_; }
+  int GetCols() const { return cols_; }
+  S21SparseFormat GetFormat() const { return format_; }
+  int GetNonZeros() const { return static_cast<int>(values_.size()); }
+  double GetDensity() const;
+
+  // массивы формата: offsets[o]..offsets[o + 1] - элементы строки (CSR)
+  // или столбца (CSC) o
+  const std::vector<int>& GetOffsets() const { return offsets_; }
+  const std::vector<int>& GetIndices() const { return indices_; }
+  const std::vector<T>& GetValues() const { return values_; }
+
+  // элемент (i, j) двоичным поиском; нулевой, если не хранится
+  T At(int i, int j) const;
+  T operator()(int i, int j) const { return At(i, j); }
+
+  // SpMV: y = A * x
+  std::vector<T> operator*(const std::vector<T>& x) const;
+  // SpMM: A * B с плотной B
+  S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& dense) const;
+  // в формате левого операнда
+  S21BasicSparseMatrix operator+(const S21BasicSparseMatrix& other) const;
+  bool operator==(const S21BasicSparseMatrix& other) const;
+
+ private:
+  // число строк (CSR) или столбцов (CSC) и длина каждой из них
+  int OuterSize() const;
+  int InnerSize() const;
+
+  int rows_, cols_;
+  S21SparseFormat format_;
+  std::vector<int> offsets_;  // OuterSize() + 1 смещений
+  std::vector<int> indices_;  // nnz внутренних индексов
+  std::vector<T> values_;     // nnz значений
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+using S21SparseMatrixF = S21BasicSparseMatrix<float>;
+using S21SparseMatrixI = S21BasicSparseMatrix<int>;
+
+// B * A с плотной B
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& dense,
+                            const S21BasicSparseMatrix<T>& sparse);
+
+// вывод в плотном виде
+template <typename T>
+std::ostream& operator<<(std::ostream& os,
+                         const S21BasicSparseMatrix<T>& matrix);
+
+#endif  // S21_SPARSE_MATRIX_H
@@ -0,0 +1,146 @@
+/**
+ * @file s21_thread_pool.h
+ * @brief Постоянный пул потоков, которым библиотека распараллеливает тяжёлые
+ * операции над матрицами.
+ */
+
+#ifndef S21_THREAD_POOL_H
+#define S21_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class S21ThreadPool
+ * @brief Пул рабочих потоков, принадлежащий библиотеке.
+ *
+ * Число потоков по умолчанию берётся из переменной окружения
+ * S21_MATRIX_NUM_THREADS, а если она не задана - из
+ * std::thread::hardware_concurrency(). Потоки создаются один раз и
+ * переиспользуются всеми операциями; вызывающий поток тоже участвует в
+ * работе, поэтому пул из N потоков держит N - 1 рабочих.
+ */
+class S21ThreadPool {
+ public:
+  // пул, которым пользуется библиотека
+  static S21ThreadPool& Instance();
+
+  explicit S21ThreadPool(int num_threads);
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool();
+
+  int GetNumThreads() const;
+  // пересоздаёт рабочие потоки; из задачи ParallelFor - std::logic_error
+  void SetNumThreads(int num_threads);
+
+  // выполняет body(0) ... body(count - 1) и ждёт завершения всех задач
+  void ParallelFor(int count, const std::function<void(int)>& body);
+
+  // диапазонов ParallelForRanges на поток: сглаживают неравномерность
+  // нагрузки между задачами
+  static constexpr int kRangesPerThread = 4;
+
+  // body(begin, end) для диапазонов [0, n) с границами, кратными step
+  template <typename Body>
+  void ParallelForRanges(int n, long long volume, long long min_volume,
+                         int step, const Body& body);
+  // то же с примерно равным весом диапазонов: offsets - n + 1
+  // неубывающих префиксных сумм веса (например, смещения CSR)
+  template <typename Body>
+  void ParallelForWeightedRanges(const int* offsets, int n, long long volume,
+                                 long long min_volume, const Body& body);
+
+ private:
+  template <typename Body>
+  void ParallelForBounds(int n, long long volume, long long min_volume,
+                         int step, const int* offsets, const Body& body);
+
+  void Start(int num_threads);
+  void Stop();
+  void WorkerLoop(unsigned long long seen_generation);
+  void RunTasks();
+
+  std::vector<std::thread> workers_;
+  // читается без блокировки (GetNumThreads, быстрый путь ParallelFor),
+  // пишется в Start под submit_mutex_
+  std::atomic<int> num_threads_;
+
+  std::mutex submit_mutex_;  // одновременно выполняется один ParallelFor
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+
+  const std::function<void(int)>* body_;
+  int task_count_;
+  std::atomic<int> next_task_;
+  int busy_workers_;
+  unsigned long long generation_;
+  std::exception_ptr error_;  // ошибка первой упавшей задачи
+  bool stopping_;
+};
+
+/**
+ * @brief Делит [0, n) на диапазоны и выполняет body(begin, end) для каждого
+ * непустого из них на потоках пула.
+ *
+ * Работа объёмом volume меньше min_volume, однопоточный пул и единственный
+ * диапазон выполняются вызывающим потоком как body(0, n). Иначе диапазонов
+ * до kRangesPerThread на поток; их границы кратны step (кроме n) и при
+ * заданных offsets выбираются двоичным поиском по весу.
+ */
+template <typename Body>
+void S21ThreadPool::ParallelForBounds(int n, long long volume,
+                                      long long min_volume, int step,
+                                      const int* offsets, const Body& body) {
+  const int threads = GetNumThreads();
+  const int chunks =
+      std::min(threads * kRangesPerThread, (n + step - 1) / step);
+  if (threads == 1 || chunks <= 1 || volume < min_volume) {
+    body(0, n);
+    return;
+  }
+  const auto bound = [&](int chunk) {
+    if (chunk == chunks) {
+      return n;
+    }
+    long long position = static_cast<long long>(n) * chunk / chunks;
+    if (offsets != nullptr) {
+      const long long target =
+          offsets[0] +
+          static_cast<long long>(offsets[n] - offsets[0]) * chunk / chunks;
+      position = std::lower_bound(offsets, offsets + n + 1, target) - offsets;
+    }
+    return static_cast<int>(std::min<long long>(n, position / step * step));
+  };
+  ParallelFor(chunks, [&](int chunk) {
+    const int begin = bound(chunk);
+    const int end = bound(chunk + 1);
+    if (begin < end) {
+      body(begin, end);
+    }
+  });
+}
+
+template <typename Body>
+void S21ThreadPool::ParallelForRanges(int n, long long volume,
+                                      long long min_volume, int step,
+                                      const Body& body) {
+  ParallelForBounds(n, volume, min_volume, step, nullptr, body);
+}
+
+template <typename Body>
+void S21ThreadPool::ParallelForWeightedRanges(const int* offsets, int n,
+                                              long long volume,
+                                              long long min_volume,
+                                              const Body& body) {
+  ParallelForBounds(n, volume, min_volume, 1, offsets, body);
+}
+
+#endif  // S21_THREAD_POOL_H
@@ -8,6 +8,7 @@ tool_gcov="gcov"
 tool_gtest="libgtest-dev"
 tool_gmock="libgmock-dev"
 tool_tbb="libtbb-dev"
+tool_benchmark="libbenchmark-dev"
 tool_pkgconfig="pkg-config"
 
 # Определение типа операционной системы
@@ -225,4 +226,18 @@ if ! dpkg -s $tool_tbb &> /dev/null; then
   fi
 else
   echo "Утилита $tool_tbb уже установлена."
+fi
+
+# Проверяем установку libbenchmark-dev
+if ! dpkg -s $tool_benchmark &> /dev/null; then
+  echo "Утилита $tool_benchmark не установлена."
+  read -p "Хотите установить утилиту $tool_benchmark? [y/n] " response
+  if [ "$response" == "y" ]; then
+    $COMMAND $tool_benchmark
+    echo "Утилита $tool_benchmark установлена."
+  else
+    echo "Утилита $tool_benchmark не будет установлена."
+  fi
+else
+  echo "Утилита $tool_benchmark уже установлена."
 fi
\ No newline at end of file
@@ -3,9 +3,63 @@
  * @brief Тесты для класса S21Matrix.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
 #include <gtest/gtest.h>
 
+#include "s21_fixed_matrix.h"
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_batch.h"
+#include "s21_matrix_file.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_stats.h"
+#include "s21_sparse_matrix.h"
+#include "s21_thread_pool.h"
+
+// Счётчик выровненных выделений памяти: буферы матриц выделяются только
+// через ::operator new(size, std::align_val_t)
+static std::atomic<long> aligned_allocations{0};
+
+void* operator new(std::size_t size, std::align_val_t align) {
+  ++aligned_allocations;
+  const std::size_t alignment = static_cast<std::size_t>(align);
+  const std::size_t rounded = (size + alignment - 1) / alignment * alignment;
+  void* ptr = std::aligned_alloc(alignment, rounded);
+  if (ptr == nullptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept { std::free(ptr); }
+
+void operator delete(void* ptr, std::size_t, std::align_val_t) noexcept {
+  std::free(ptr);
+}
+
+/**
+ * @brief Возвращает число буферов, выделенных при выполнении body.
+ */
+template <typename Body>
+static long CountAllocations(Body body) {
+  const long before = aligned_allocations;
+  body();
+  return aligned_allocations - before;
+}
 
 // --> Тесты конструкторов
 
@@ -586,6 +640,1559 @@ TEST(S21MatrixTest, InverseMatrixSingularMatrixExceptionTest) {
   ASSERT_THROW(singularMatrix.InverseMatrix(), std::logic_error);
 }
 
+/**
+ * @brief Проверяет непрерывное построчное размещение элементов в буфере.
+ */
+TEST(S21MatrixTest, ContiguousStorageTest) {
+  S21Matrix matrix(3, 5);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      matrix(i, j) = i * 10 + j;
+    }
+  }
+
+  ASSERT_GE(matrix.GetStride(), matrix.GetCols());
+  ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(matrix.data()) % 64);
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(matrix.data() + i * matrix.GetStride(), matrix.row(i));
+    for (int j = 0; j < 5; ++j) {
+      ASSERT_EQ(&matrix(i, j), matrix.row(i) + j);
+      ASSERT_EQ(i * 10 + j, matrix.row(i)[j]);
+    }
+  }
+}
+
+/**
+ * @brief Проверяет уменьшение размера и мутаторы SetRows/SetCols.
+ */
+TEST(S21MatrixTest, ShrinkAndSettersTest) {
+  S21Matrix matrix(3, 3);
+  matrix(0, 0) = 1.0;
+  matrix(0, 1) = 2.0;
+  matrix(1, 0) = 3.0;
+  matrix(1, 1) = 4.0;
+  matrix(2, 2) = 9.0;
+
+  matrix.Resize(2, 2);
+  S21Matrix expected(2, 2);
+  expected(0, 0) = 1.0;
+  expected(0, 1) = 2.0;
+  expected(1, 0) = 3.0;
+  expected(1, 1) = 4.0;
+  ASSERT_EQ(expected, matrix);
+
+  matrix.SetRows(4);
+  matrix.SetCols(1);
+  ASSERT_EQ(4, matrix.GetRows());
+  ASSERT_EQ(1, matrix.GetCols());
+  ASSERT_EQ(1.0, matrix(0, 0));
+  ASSERT_EQ(3.0, matrix(1, 0));
+  ASSERT_EQ(0.0, matrix(3, 0));
+
+  ASSERT_THROW(S21Matrix(-1, 2), std::invalid_argument);
+}
+
+/**
+ * @brief Проверяет, что перенос забирает буфер и оставляет пустую матрицу.
+ *
+ * Матрица 8x8 больше встроенного буфера и лежит в куче.
+ */
+TEST(S21MatrixTest, MoveConstructorStealsBufferTest) {
+  S21Matrix matrix1(8, 8);
+  const double* buffer = matrix1.data();
+
+  S21Matrix matrix2(std::move(matrix1));
+  ASSERT_EQ(buffer, matrix2.data());
+  ASSERT_EQ(0, matrix1.GetRows());
+  ASSERT_EQ(nullptr, matrix1.data());
+}
+
+/**
+ * @brief Сверяет блочное умножение с поэлементной формулой на размерах,
+ * не кратных размерам блоков.
+ */
+TEST(MatrixMethodsTest, BlockedMulMatrixTest) {
+  const int m = 131, k = 259, n = 70;
+  S21Matrix a(m, k);
+  S21Matrix b(k, n);
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < k; ++j) {
+      a(i, j) = ((i * 7 + j * 3) % 11) - 5;
+    }
+  }
+  for (int i = 0; i < k; ++i) {
+    for (int j = 0; j < n; ++j) {
+      b(i, j) = ((i * 5 + j * 13) % 17) - 8;
+    }
+  }
+
+  S21Matrix result = a * b;
+  ASSERT_EQ(m, result.GetRows());
+  ASSERT_EQ(n, result.GetCols());
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      double expected = 0.0;
+      for (int p = 0; p < k; ++p) {
+        expected += a(i, p) * b(p, j);
+      }
+      ASSERT_EQ(expected, result(i, j));
+    }
+  }
+}
+
+/**
+ * @brief Проверяет определитель большой матрицы через LU-разложение.
+ *
+ * Определитель трёхдиагональной матрицы (2, -1) размера n равен n + 1.
+ */
+TEST(MatrixMethodsTest, DeterminantLargeMatrixTest) {
+  const int n = 40;
+  S21Matrix matrix(n, n);
+  for (int i = 0; i < n; ++i) {
+    matrix(i, i) = 2.0;
+    if (i + 1 < n) {
+      matrix(i, i + 1) = -1.0;
+      matrix(i + 1, i) = -1.0;
+    }
+  }
+  ASSERT_NEAR(n + 1.0, matrix.Determinant(), 1e-9);
+
+  // вырожденная матрица: две одинаковые строки
+  S21Matrix singular(5, 5);
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      singular(i, j) = (i == 4) ? singular(0, j) : i * 5 + j * j + 1;
+    }
+  }
+  ASSERT_NEAR(0.0, singular.Determinant(), 1e-9);
+}
+
+/**
+ * @brief Проверяет, что упакованные множители LU восстанавливают P * A.
+ */
+TEST(MatrixMethodsTest, LUDecompositionTest) {
+  S21Matrix a(4, 4);
+  const double values[4][4] = {
+      {2, 1, 1, 0}, {4, 3, 3, 1}, {8, 7, 9, 5}, {6, 7, 9, 8}};
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      a(i, j) = values[i][j];
+    }
+  }
+
+  S21MatrixLU lu = a.LU();
+  ASSERT_EQ(4, lu.GetSize());
+  ASSERT_FALSE(lu.IsSingular());
+  ASSERT_NEAR(8.0, lu.Determinant(), 1e-9);
+
+  // P * A: применяем перестановки строк в порядке шагов
+  S21Matrix permuted = a;
+  for (int k = 0; k < 4; ++k) {
+    const int p = lu.GetPivots()[k];
+    for (int j = 0; j < 4; ++j) {
+      std::swap(permuted(k, j), permuted(p, j));
+    }
+  }
+
+  const S21Matrix& packed = lu.GetLU();
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      double sum = 0.0;
+      for (int k = 0; k <= std::min(i, j); ++k) {
+        const double l = (k == i) ? 1.0 : packed(i, k);
+        sum += l * packed(k, j);
+      }
+      ASSERT_NEAR(permuted(i, j), sum, 1e-12);
+    }
+  }
+
+  S21Matrix rect(2, 3);
+  ASSERT_THROW(rect.LU(), std::logic_error);
+}
+
+/**
+ * @brief Проверяет, что A * A^-1 = E для большой матрицы и что обращение на
+ * месте совпадает с InverseMatrix.
+ */
+TEST(MatrixMethodsTest, InverseMatrixLargeTest) {
+  const int n = 37;
+  S21Matrix a(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = ((i * 31 + j * 17) % 23) / 7.0 + (i == j ? n : 0.0);
+    }
+  }
+
+  S21Matrix inverse = a.InverseMatrix();
+  S21Matrix product = a * inverse;
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      ASSERT_NEAR(i == j ? 1.0 : 0.0, product(i, j), 1e-12);
+    }
+  }
+
+  S21Matrix in_place = a;
+  in_place.InverseMatrixInPlace();
+  ASSERT_EQ(inverse, in_place);
+}
+
+/**
+ * @brief Проверяет, что вырожденность определяется по ведущим элементам, а
+ * не по абсолютной величине определителя.
+ */
+TEST(MatrixMethodsTest, InverseMatrixConditionTest) {
+  // определитель 1e-9, но матрица идеально обусловлена
+  S21Matrix scaled(3, 3);
+  scaled(0, 0) = 1e-3;
+  scaled(1, 1) = 1e-3;
+  scaled(2, 2) = 1e-3;
+  S21Matrix inverse = scaled.InverseMatrix();
+  ASSERT_DOUBLE_EQ(1e3, inverse(0, 0));
+  ASSERT_DOUBLE_EQ(1e3, inverse(2, 2));
+
+  // численно вырожденная матрица
+  S21Matrix singular(3, 3);
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      singular(i, j) = i * 3 + j + 1;
+    }
+  }
+  ASSERT_TRUE(singular.LU().IsSingular());
+  ASSERT_THROW(singular.InverseMatrix(), std::logic_error);
+  ASSERT_THROW(singular.InverseMatrixInPlace(), std::logic_error);
+}
+
+/**
+ * @brief Эталон: алгебраические дополнения по определению, через миноры.
+ */
+static S21Matrix ComplementsByMinors(const S21Matrix& matrix) {
+  S21Matrix result(matrix.GetRows(), matrix.GetCols());
+  for (int x = 0; x < matrix.GetRows(); ++x) {
+    for (int y = 0; y < matrix.GetCols(); ++y) {
+      int sign = ((x + y) % 2 == 0) ? 1 : -1;
+      result(x, y) = sign * matrix.GetMatrixMinor(x, y).Determinant();
+    }
+  }
+  return result;
+}
+
+/**
+ * @brief Сверяет дополнения, полученные из разложения, с определением для
+ * невырожденной матрицы и матриц ранга n - 1 и n - 2.
+ */
+TEST(MatrixMethodsTest, CalcComplementsFactorizationTest) {
+  const int n = 6;
+  S21Matrix full(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      full(i, j) = ((i * 7 + j * 5) % 9) - 4 + (i == j ? 3 : 0);
+    }
+  }
+
+  // ранг n - 1: последняя строка - сумма двух первых
+  S21Matrix rank_deficient = full;
+  for (int j = 0; j < n; ++j) {
+    rank_deficient(n - 1, j) = full(0, j) + full(1, j);
+  }
+
+  // ранг n - 2: две последние строки зависимы
+  S21Matrix rank_two_less = rank_deficient;
+  for (int j = 0; j < n; ++j) {
+    rank_two_less(n - 2, j) = 2.0 * full(0, j);
+  }
+
+  for (const S21Matrix* matrix : {&full, &rank_deficient, &rank_two_less}) {
+    S21Matrix expected = ComplementsByMinors(*matrix);
+    S21Matrix result = matrix->CalcComplements();
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        ASSERT_NEAR(expected(i, j), result(i, j), 1e-8);
+      }
+    }
+  }
+}
+
+/**
+ * @brief Проверяет, что пул выполняет каждую задачу ровно один раз и
+ * пробрасывает исключения задач.
+ */
+TEST(S21ThreadPoolTest, ParallelForTest) {
+  S21ThreadPool pool(4);
+  ASSERT_EQ(4, pool.GetNumThreads());
+
+  std::vector<int> hits(1000, 0);
+  pool.ParallelFor(1000, [&](int task) { ++hits[task]; });
+  for (int hit : hits) {
+    ASSERT_EQ(1, hit);
+  }
+
+  ASSERT_THROW(pool.ParallelFor(8,
+                                [](int task) {
+                                  if (task == 5) {
+                                    throw std::runtime_error("task failed");
+                                  }
+                                }),
+               std::runtime_error);
+
+  // из задачи пул не перестраивается: внешний вызов ждал бы сам себя
+  ASSERT_THROW(pool.ParallelFor(4, [&](int) { pool.SetNumThreads(2); }),
+               std::logic_error);
+  ASSERT_EQ(4, pool.GetNumThreads());
+
+  pool.SetNumThreads(2);
+  ASSERT_EQ(2, pool.GetNumThreads());
+  std::atomic<int> sum(0);
+  pool.ParallelFor(100, [&](int task) { sum += task; });
+  ASSERT_EQ(4950, sum.load());
+}
+
+/**
+ * @brief Проверяет, что диапазоны ParallelForRanges покрывают [0, n) ровно
+ * один раз с границами, кратными шагу, а взвешенные делят вес поровну.
+ */
+TEST(S21ThreadPoolTest, ParallelForRangesTest) {
+  S21ThreadPool pool(4);
+  const int n = 1000, step = 16;
+  std::vector<int> hits(n, 0);
+  std::atomic<int> ranges(0);
+  pool.ParallelForRanges(n, 1, 0, step, [&](int begin, int end) {
+    ASSERT_EQ(0, begin % step);
+    ASSERT_TRUE(end == n || end % step == 0);
+    for (int i = begin; i < end; ++i) {
+      ++hits[i];
+    }
+    ++ranges;
+  });
+  for (int hit : hits) {
+    ASSERT_EQ(1, hit);
+  }
+  ASSERT_EQ(4 * S21ThreadPool::kRangesPerThread, ranges.load());
+
+  // ниже порога весь диапазон обрабатывается одним вызовом
+  ranges = 0;
+  pool.ParallelForRanges(n, 1, 2, step, [&](int begin, int end) {
+    ASSERT_EQ(0, begin);
+    ASSERT_EQ(n, end);
+    ++ranges;
+  });
+  ASSERT_EQ(1, ranges.load());
+
+  // весь вес в первых десяти элементах: они делятся между диапазонами
+  std::vector<int> offsets(n + 1);
+  for (int i = 0; i <= n; ++i) {
+    offsets[i] = std::min(i, 10) * 100;
+  }
+  std::fill(hits.begin(), hits.end(), 0);
+  std::atomic<int> heavy_ranges(0);
+  pool.ParallelForWeightedRanges(
+      offsets.data(), n, 1, 0, [&](int begin, int end) {
+        for (int i = begin; i < end; ++i) {
+          ++hits[i];
+        }
+        if (begin < 10) {
+          ++heavy_ranges;
+        }
+      });
+  for (int hit : hits) {
+    ASSERT_EQ(1, hit);
+  }
+  ASSERT_EQ(10, heavy_ranges.load());
+}
+
+/**
+ * @brief Проверяет, что разбиение на тайлы между потоками не меняет
+ * результат умножения.
+ */
+TEST(S21ThreadPoolTest, ParallelMulMatrixTest) {
+  const int n = 300;
+  S21Matrix a(n, n);
+  S21Matrix b(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = ((i + 2 * j) % 13) - 6;
+      b(i, j) = ((3 * i + j) % 7) - 3;
+    }
+  }
+
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  const int initial_threads = pool.GetNumThreads();
+  pool.SetNumThreads(1);
+  S21Matrix serial = a * b;
+  pool.SetNumThreads(4);
+  S21Matrix parallel = a * b;
+  pool.SetNumThreads(initial_threads);
+
+  ASSERT_EQ(serial, parallel);
+}
+
+/**
+ * @brief Прогоняет поэлементные операции на всех доступных наборах
+ * инструкций и сверяет со скалярным путём.
+ */
+TEST(S21SimdTest, KernelsMatchScalarTest) {
+  const int rows = 13, cols = 11;
+  S21Matrix a(rows, cols);
+  S21Matrix b(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      a(i, j) = i * 0.5 - j * 0.25;
+      b(i, j) = (i * j) % 7 - 3.0;
+    }
+  }
+
+  using s21::simd::Isa;
+  const Isa initial = s21::simd::ActiveIsa();
+  ASSERT_EQ(Isa::kScalar, s21::simd::SetIsa(Isa::kScalar));
+  S21Matrix sum = a + b;
+  S21Matrix diff = a;
+  diff -= b;
+  S21Matrix scaled = a;
+  scaled.MulNumber(-1.5);
+  S21Matrix transposed = a.Transpose();
+
+  for (Isa isa : {Isa::kSse2, Isa::kAvx2, Isa::kAvx512}) {
+    if (s21::simd::SetIsa(isa) != isa) {
+      continue;  // процессор не поддерживает этот набор
+    }
+    SCOPED_TRACE(s21::simd::IsaName(isa));
+    ASSERT_EQ(sum, a + b);
+    S21Matrix current = a;
+    current -= b;
+    ASSERT_EQ(diff, current);
+    current = a;
+    current.MulNumber(-1.5);
+    ASSERT_EQ(scaled, current);
+    ASSERT_EQ(transposed, a.Transpose());
+    current = a;
+    current(rows - 1, cols - 1) += 1.0;
+    ASSERT_FALSE(current == a);
+  }
+  s21::simd::SetIsa(initial);
+}
+
+/**
+ * @brief Цепочка операторов вычисляется одним проходом и совпадает с
+ * поэлементным расчётом, в том числе при присваивании самой себе.
+ */
+TEST(S21MatrixTest, ExpressionTemplatesTest) {
+  const int rows = 5, cols = 7;
+  S21Matrix a(rows, cols);
+  S21Matrix b(rows, cols);
+  S21Matrix c(rows, cols);
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      a(i, j) = i + j;
+      b(i, j) = i * j - 3.0;
+      c(i, j) = 0.5 * i - j;
+    }
+  }
+
+  S21Matrix result = a + b - c * 2;
+  S21Matrix scaled;
+  scaled = 0.5 * (a - b) + c;
+  for (int i = 0; i < rows; ++i) {
+    for (int j = 0; j < cols; ++j) {
+      ASSERT_DOUBLE_EQ(a(i, j) + b(i, j) - c(i, j) * 2, result(i, j));
+      ASSERT_DOUBLE_EQ(0.5 * (a(i, j) - b(i, j)) + c(i, j), scaled(i, j));
+    }
+  }
+
+  S21Matrix expected = a;
+  expected.SumMatrix(b);
+  expected.SumMatrix(b);
+  a = a + b * 2.0;
+  ASSERT_EQ(expected, a);
+
+  expected.SubMatrix(c);
+  expected.SubMatrix(c);
+  a -= c + c;
+  ASSERT_EQ(expected, a);
+
+  S21Matrix wrong(rows, cols + 1);
+  ASSERT_THROW(a + b - wrong, std::invalid_argument);
+  ASSERT_THROW(a += b * 3.0 + wrong, std::invalid_argument);
+}
+
+/**
+ * @brief Перенос и операторы для временных матриц не копируют буферы.
+ */
+TEST(S21MatrixTest, MoveAssignmentTest) {
+  const int n = 6;
+  S21Matrix a(n, n);
+  S21Matrix b(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = i - j;
+      b(i, j) = i * j + 1.0;
+    }
+  }
+  S21Matrix product = a * b;
+  S21Matrix expected = product;
+  expected.SumMatrix(a);
+  expected.MulNumber(2.0);
+
+  S21Matrix result(n, n);
+  S21Matrix moved;
+  const double* buffer = result.data();
+  ASSERT_EQ(0, CountAllocations([&] { moved = std::move(result); }));
+  ASSERT_EQ(buffer, moved.data());
+  ASSERT_EQ(0, result.GetRows());
+  ASSERT_EQ(nullptr, result.data());
+
+  // одно выделение - под само произведение
+  ASSERT_EQ(1, CountAllocations([&] { result = a * b; }));
+  ASSERT_EQ(product, result);
+  ASSERT_EQ(1, CountAllocations([&] { result = (a * b + a) * 2.0; }));
+  ASSERT_EQ(expected, result);
+  ASSERT_EQ(1, CountAllocations([&] { result = 2.0 * (a + a * b); }));
+  ASSERT_EQ(expected, result);
+  ASSERT_EQ(1, CountAllocations([&] { result.MulMatrix(b); }));
+
+  // поэлементные выражения пишут прямо в буфер результата
+  ASSERT_EQ(0, CountAllocations([&] { result = a + b - a * 2.0; }));
+  ASSERT_EQ(1, CountAllocations([&] { S21Matrix sum = a + b + a; }));
+  // два произведения, разность пишется в буфер первого
+  ASSERT_EQ(2, CountAllocations([&] { result = a * b - (a * b); }));
+  ASSERT_EQ(S21Matrix(n, n), result);
+}
+
+/**
+ * @brief Блоки и миноры без копирования совпадают с их копиями во всех
+ * операциях только для чтения.
+ */
+TEST(S21MatrixTest, MatrixViewTest) {
+  const int n = 7;
+  S21Matrix a(n, n);
+  S21Matrix b(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = ((i * 5 + j * 3) % 11) - 5 + (i == j ? 4 : 0);
+      b(i, j) = (i * j) % 7 - 2.0 * j;
+    }
+  }
+
+  S21MatrixView block = a.Block(1, 2, 4, 3);
+  ASSERT_EQ(4, block.GetRows());
+  ASSERT_EQ(3, block.GetCols());
+  ASSERT_EQ(&a(1, 2), block.data());
+  ASSERT_EQ(a(4, 4), block(3, 2));
+  ASSERT_THROW(a.Block(5, 0, 3, 1), std::out_of_range);
+  ASSERT_THROW(a.MinorView(n, 0), std::out_of_range);
+
+  S21Matrix product(n - 1, n - 1);
+  for (int row = 0; row < n; row += 3) {
+    for (int col = 0; col < n; col += 2) {
+      S21MatrixView minor = a.MinorView(row, col);
+      S21Matrix copy = a.GetMatrixMinor(row, col);
+      ASSERT_EQ(copy, minor);
+      ASSERT_DOUBLE_EQ(copy.Determinant(), minor.Determinant());
+      // блок минора: пропуск сдвигается вместе с началом блока
+      ASSERT_EQ(copy.Block(1, 1, 3, 4), minor.Block(1, 1, 3, 4));
+      ASSERT_EQ(0, CountAllocations(
+                       [&] { minor.Block(2, 0, 3, 3).Determinant(); }));
+
+      S21MatrixView other = b.MinorView(col, row);
+      S21Matrix other_copy = b.GetMatrixMinor(col, row);
+      ASSERT_EQ(1, CountAllocations([&] { product = minor * other; }));
+      S21Matrix expected = copy * other_copy;
+      for (int i = 0; i < n - 1; ++i) {
+        for (int j = 0; j < n - 1; ++j) {
+          ASSERT_NEAR(expected(i, j), product(i, j), 1e-9);
+        }
+      }
+      ASSERT_EQ(copy + other_copy * 2.0, S21Matrix(minor + other * 2.0));
+    }
+  }
+
+  std::ostringstream from_view, from_copy;
+  from_view << a.Block(0, 0, 2, 2);
+  from_copy << S21Matrix(a.Block(0, 0, 2, 2));
+  ASSERT_EQ(from_copy.str(), from_view.str());
+  ASSERT_FALSE(a.Block(0, 0, 2, 2) == a.Block(1, 1, 2, 2));
+}
+
+/**
+ * @brief Блочное транспонирование на размерах, не кратных блокам, и
+ * транспонирование на месте без выделения памяти.
+ */
+TEST(MatrixMethodsTest, BlockedTransposeTest) {
+  for (int rows : {1, 5, 33, 70, 131}) {
+    for (int cols : {1, 31, 64, 97}) {
+      S21Matrix matrix(rows, cols);
+      for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+          matrix(i, j) = i * 1000 + j;
+        }
+      }
+      S21Matrix transposed = matrix.Transpose();
+      ASSERT_EQ(cols, transposed.GetRows());
+      ASSERT_EQ(rows, transposed.GetCols());
+      for (int i = 0; i < rows; ++i) {
+        for (int j = 0; j < cols; ++j) {
+          ASSERT_EQ(matrix(i, j), transposed(j, i));
+        }
+      }
+
+      if (rows != cols) {
+        ASSERT_THROW(matrix.TransposeInPlace(), std::logic_error);
+      }
+    }
+  }
+  for (int n : {1, 5, 33, 70, 131}) {
+    S21Matrix square(n, n);
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < n; ++j) {
+        square(i, j) = i * 1000 + j;
+      }
+    }
+    S21Matrix expected = square.Transpose();
+    ASSERT_EQ(0, CountAllocations([&] { square.TransposeInPlace(); }));
+    ASSERT_EQ(expected, square);
+  }
+}
+
+/**
+ * @brief Транспонированные представления умножаются без копии и дают тот же
+ * результат, что и явный Transpose; присваивание с наложением безопасно.
+ */
+TEST(MatrixMethodsTest, TransposeViewTest) {
+  const int m = 70, k = 45, n = 38;
+  S21Matrix a(k, m);  // в произведении участвует a^T (m x k)
+  S21Matrix b(n, k);  // и b^T (k x n)
+  for (int i = 0; i < k; ++i) {
+    for (int j = 0; j < m; ++j) {
+      a(i, j) = ((i * 7 + j * 3) % 13) - 6;
+    }
+    for (int j = 0; j < n; ++j) {
+      b(j, i) = ((i * 5 + j * 11) % 9) - 4;
+    }
+  }
+  const S21Matrix a_t = a.Transpose();
+  const S21Matrix b_t = b.Transpose();
+  const S21Matrix expected = a_t * b_t;
+
+  S21Matrix product;
+  ASSERT_EQ(1, CountAllocations([&] { product = a.TransposeView() * b_t; }));
+  ASSERT_EQ(expected, product);
+  ASSERT_EQ(1, CountAllocations([&] { product = a_t * b.TransposeView(); }));
+  ASSERT_EQ(expected, product);
+  product = a.TransposeView() * b.TransposeView();
+  ASSERT_EQ(expected, product);
+  product = a_t;
+  product.MulMatrix(b.TransposeView());
+  ASSERT_EQ(expected, product);
+
+  ASSERT_EQ(a_t, a.TransposeView());
+  ASSERT_EQ(a, a.TransposeView().Transposed());
+  ASSERT_EQ(a_t, S21Matrix(a.TransposeView()));
+  ASSERT_EQ(a_t * 2.0, S21Matrix(a.TransposeView() * 2.0));
+
+  // выражение читает *this в других позициях
+  S21Matrix square = a.Block(0, 0, k, k);
+  S21Matrix symmetric = square + square.Transpose();
+  square += square.TransposeView();
+  ASSERT_EQ(symmetric, square);
+  square = square.TransposeView() - square;
+  ASSERT_EQ(S21Matrix(k, k), square);
+
+  // транспонированные блоки миноров сохраняют пропуск строки или столбца
+  S21Matrix small(4, 4);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      small(i, j) = (i + 1) * 10 + j + 1;
+    }
+  }
+  for (int r = 0; r < 4; ++r) {
+    for (int c = 0; c < 4; ++c) {
+      const S21MatrixView view =
+          small.MinorView(r, c).Block(0, 0, 3, 3).Transposed();
+      const S21Matrix copy(view);
+      for (int i = 0; i < 3; ++i) {
+        for (int j = 0; j < 3; ++j) {
+          ASSERT_EQ(view.At(i, j), copy(i, j));
+        }
+      }
+    }
+  }
+}
+
+/**
+ * @brief Пул и арена переиспользуют буферы временных матриц без обращения к
+ * ::operator new, а матрицы, пережившие арену, остаются действительными.
+ */
+TEST(S21MatrixTest, AllocatorTest) {
+  const int n = 8;
+  S21Matrix a(n, n);
+  S21Matrix b(n, n);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      a(i, j) = i + j;
+      b(i, j) = i - j;
+    }
+  }
+  const S21Matrix expected = a * b + a;
+
+  S21MatrixAllocator::ResetStats();
+  {
+    S21MatrixAllocatorScope scope(S21MatrixAllocator::Pool());
+    { S21Matrix warm_up = a * b + a; }
+    ASSERT_EQ(0, CountAllocations([&] {
+                for (int iteration = 0; iteration < 100; ++iteration) {
+                  S21Matrix result = a * b + a;
+                  ASSERT_EQ(expected, result);
+                }
+              }));
+  }
+  // запросы к Global() не входят в долю попаданий пула
+  { S21Matrix global = a * b; }
+  S21MatrixAllocatorStats stats = S21MatrixAllocator::GetStats();
+  ASSERT_EQ(102u, stats.allocations);
+  ASSERT_EQ(100u, stats.pool_hits);
+  ASSERT_EQ(1u, stats.pool_misses);
+  ASSERT_NEAR(100.0 / 101.0, stats.HitRate(), 1e-12);
+  ASSERT_EQ(&S21MatrixAllocator::Global(), &S21MatrixAllocator::Current());
+
+  S21MatrixAllocator::ResetStats();
+  S21Matrix escaped;
+  {
+    S21MatrixArena arena(1 << 16);
+    ASSERT_NE(&S21MatrixAllocator::Global(), &S21MatrixAllocator::Current());
+    for (int iteration = 0; iteration < 100; ++iteration) {
+      S21Matrix result = a * b + a;
+      ASSERT_EQ(expected, result);
+    }
+    escaped = a * b;
+    escaped += a;
+  }
+  ASSERT_EQ(&S21MatrixAllocator::Global(), &S21MatrixAllocator::Current());
+  ASSERT_EQ(expected, escaped);
+  stats = S21MatrixAllocator::GetStats();
+  ASSERT_EQ(101u, stats.arena_allocations);
+  ASSERT_EQ(1u, stats.system_allocations);  // один кусок арены
+}
+
+/**
+ * @brief Матрицы float и int: блочный GEMM (в том числе с транспонированным
+ * представлением) совпадает с наивным циклом, а целые определитель и
+ * алгебраические дополнения считаются точно.
+ */
+TEST(S21MatrixTest, ElementTypesTest) {
+  const int m = 67, k = 45, n = 53;  // больше порога упаковки GEMM
+  S21MatrixF af(m, k), bf(k, n);
+  S21MatrixI ai(m, k), bi(k, n);
+  for (int i = 0; i < k; ++i) {
+    for (int j = 0; j < m; ++j) {
+      ai(j, i) = ((i * 7 + j * 3) % 13) - 6;
+      af(j, i) = ai(j, i) * 0.5f;
+    }
+    for (int j = 0; j < n; ++j) {
+      bi(i, j) = ((i * 5 + j * 11) % 9) - 4;
+      bf(i, j) = bi(i, j) * 0.25f;
+    }
+  }
+
+  const S21MatrixF product_f = af * bf;
+  const S21MatrixI product_i = ai * bi;
+  for (int i = 0; i < m; ++i) {
+    for (int j = 0; j < n; ++j) {
+      long long expected = 0;
+      for (int p = 0; p < k; ++p) {
+        expected += static_cast<long long>(ai(i, p)) * bi(p, j);
+      }
+      ASSERT_EQ(expected, product_i(i, j));
+      // множители 1/2 и 1/4 и небольшие целые: сумма в float точна
+      ASSERT_EQ(expected * 0.125f, product_f(i, j));
+    }
+  }
+  ASSERT_EQ(product_i, ai.Transpose().TransposeView() * bi);
+  ASSERT_EQ(product_f, S21MatrixF(af.TransposeView()).TransposeView() * bf);
+
+  // смешанные выражения приводятся к типу приёмника
+  S21MatrixI doubled = ai + ai;
+  ASSERT_EQ(S21MatrixI(ai * 2.0), doubled);
+  doubled.MulNumber(0.5);
+  ASSERT_EQ(ai, doubled);
+  ASSERT_EQ(S21Matrix(af), S21Matrix(ai * 0.5));
+
+  S21MatrixI c(5, 5);
+  const int values[5][5] = {{2, -1, 0, 3, 1},
+                            {4, 0, 1, -2, 5},
+                            {0, 3, -1, 1, 2},
+                            {1, 2, 3, 0, -1},
+                            {-3, 1, 2, 4, 0}};
+  S21Matrix c_double(5, 5);
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      c(i, j) = values[i][j];
+      c_double(i, j) = values[i][j];
+    }
+  }
+  ASSERT_EQ(std::llround(c_double.Determinant()), c.Determinant());
+  const S21Matrix complements_double = c_double.CalcComplements();
+  const S21MatrixI complements = c.CalcComplements();
+  for (int i = 0; i < 5; ++i) {
+    for (int j = 0; j < 5; ++j) {
+      ASSERT_EQ(std::llround(complements_double(i, j)), complements(i, j));
+    }
+  }
+  ASSERT_THROW(c.InverseMatrix(), std::logic_error);
+  ASSERT_EQ(c, c.Transpose().Transpose());
+}
+
+/**
+ * @brief Матрицы фиксированного размера: constexpr-вычисления, явные
+ * формулы определителя и обратной матрицы и обмен с S21Matrix.
+ */
+TEST(S21MatrixTest, FixedMatrixTest) {
+  constexpr S21Matrix2 a(1, 2, 3, 4);
+  static_assert(a.Determinant() == -2.0);
+  static_assert((a * a)(1, 0) == 15.0);
+  static_assert(a.Transpose()(0, 1) == 3.0);
+  static_assert(a * S21Matrix2::Identity() == a);
+  static_assert(a.InverseMatrix() * a == S21Matrix2::Identity());
+  static_assert(sizeof(S21Matrix4) == 16 * sizeof(double));
+  // конструктор из значений явный и требует ровно R * C значений
+  static_assert(std::is_constructible_v<S21FixedMatrix<1, 1>, double>);
+  static_assert(!std::is_convertible_v<double, S21FixedMatrix<1, 1>>);
+  static_assert(!std::is_constructible_v<S21Matrix2, int>);
+  static_assert(!std::is_constructible_v<S21Matrix2, int, int, int>);
+
+  constexpr S21FixedMatrix<2, 3> b(1, 0, 2, -1, 3, 1);
+  constexpr S21FixedMatrix<3, 2> c(3, 1, 2, 1, 1, 0);
+  static_assert(b * c == S21Matrix2(5, 1, 4, 2));
+
+  const S21Matrix4 m(4, 7, 2, 3, 0, 5, -1, 8, 2, -3, 6, 1, 1, 2, 0, 9);
+  const S21Matrix dynamic(m);
+  ASSERT_EQ(4, dynamic.GetRows());
+  ASSERT_EQ(dynamic, m);
+  ASSERT_NEAR(dynamic.Determinant(), m.Determinant(), 1e-9);
+  const S21Matrix4 inverse = m.InverseMatrix();
+  const S21Matrix dynamic_inverse = dynamic.InverseMatrix();
+  const S21Matrix4 identity = m * inverse;
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      ASSERT_NEAR(dynamic_inverse(i, j), inverse(i, j), 1e-12);
+      ASSERT_NEAR(i == j ? 1.0 : 0.0, identity(i, j), 1e-12);
+    }
+  }
+
+  const S21Matrix3 r(2, -1, 0, 1, 3, 2, 0, 1, 4);
+  const S21Matrix r_dynamic(r);
+  ASSERT_NEAR(r_dynamic.Determinant(), r.Determinant(), 1e-12);
+  const S21Matrix r_inverse(r.InverseMatrix());
+  const S21Matrix r_dynamic_inverse = r_dynamic.InverseMatrix();
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      ASSERT_NEAR(r_dynamic_inverse(i, j), r_inverse(i, j), 1e-15);
+    }
+  }
+  ASSERT_EQ(r_dynamic * r_dynamic, S21Matrix(r * r));
+  ASSERT_EQ(r_dynamic * r_dynamic, r * r_dynamic);
+  S21Matrix sum = r_dynamic + r;
+  ASSERT_EQ(S21Matrix(r * 2.0), sum);
+
+  ASSERT_THROW(S21Matrix3(S21Matrix(2, 3)), std::invalid_argument);
+  ASSERT_THROW(S21Matrix2(1, 2, 2, 4).InverseMatrix(), std::logic_error);
+  ASSERT_THROW(S21Matrix2(1, 1, 1, 1 + 2.3e-16).InverseMatrix(),
+               std::logic_error);
+  ASSERT_NO_THROW(S21Matrix2(1e-100, 0, 0, 1e-100).InverseMatrix());
+}
+
+/**
+ * @brief Проверяет встроенное хранение малых матриц: создание, копирование,
+ * перенос и выражения над ними не выделяют память.
+ */
+TEST(S21MatrixTest, SmallBufferTest) {
+  S21Matrix a(4, 4);
+  S21Matrix column(16, 1);
+  for (int i = 0; i < 4; ++i) {
+    for (int j = 0; j < 4; ++j) {
+      a(i, j) = i * 4 + j;
+      column(i * 4 + j, 0) = i * 4 + j;
+    }
+  }
+  const char* object = reinterpret_cast<const char*>(&a);
+  const char* data = reinterpret_cast<const char*>(a.data());
+  const bool is_inline = object <= data && data < object + sizeof(a);
+  ASSERT_EQ(16 <= S21_MATRIX_INLINE_CAPACITY, is_inline);
+  ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(a.data()) % 64);
+
+  const long allocations = CountAllocations([&] {
+    S21Matrix copy(a);
+    S21Matrix moved(std::move(copy));
+    ASSERT_EQ(0, copy.GetRows());
+    ASSERT_EQ(nullptr, copy.data());
+    ASSERT_EQ(a, moved);
+
+    S21Matrix assigned(2, 2);
+    assigned = a;
+    assigned = std::move(moved);
+    ASSERT_EQ(a, assigned);
+
+    S21Matrix r = a + assigned * 2;
+    r *= a;
+    r.Resize(3, 5);
+    ASSERT_DOUBLE_EQ(3 * (a * a)(2, 3), r(2, 3));
+    ASSERT_DOUBLE_EQ(15, column.Transpose().data()[15]);
+  });
+  if (16 <= S21_MATRIX_INLINE_CAPACITY) {
+    ASSERT_EQ(0, allocations);
+  }
+
+  // переход через порог в обе стороны сохраняет элементы
+  S21Matrix resized(a);
+  ASSERT_EQ(1, CountAllocations([&] { resized.Resize(5, 5); }));
+  resized(4, 4) = 1;
+  resized.Resize(4, 4);
+  ASSERT_EQ(a, resized);
+}
+
+/**
+ * @brief Сверяет разреженные матрицы CSR и CSC с плотными: преобразования,
+ * SpMV, SpMM, сумму и транспонирование.
+ */
+TEST(S21MatrixTest, SparseMatrixTest) {
+  const int n = 300;
+  const int k = 500;
+  S21Matrix a(n, n);
+  S21Matrix b(n, k);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      // около 5% ненулевых
+      if ((i * 7 + j * 13) % 20 == 0) {
+        a(i, j) = (i - j) * 0.25 + 1.0;
+      }
+    }
+    for (int j = 0; j < k; ++j) {
+      b(i, j) = std::sin(i + 2.0 * j);
+    }
+  }
+
+  ASSERT_TRUE(S21SparseMatrix::IsSparse(a));
+  ASSERT_FALSE(S21SparseMatrix::IsSparse(b));
+  ASSERT_NEAR(0.05, S21SparseMatrix::Density(a), 1e-3);
+
+  const S21SparseMatrix csr(a);
+  const S21SparseMatrix csc(a, S21SparseFormat::kCsc);
+  ASSERT_EQ(S21SparseFormat::kCsc, csc.GetFormat());
+  ASSERT_EQ(csr.GetNonZeros(), csc.GetNonZeros());
+  ASSERT_EQ(csr.GetNonZeros(), csr.GetOffsets().back());
+  ASSERT_EQ(a, csr.ToDense());
+  ASSERT_EQ(a, csc.ToDense());
+  ASSERT_TRUE(csr == csc);
+  ASSERT_TRUE(csr == csc.ToCsr());
+  ASSERT_DOUBLE_EQ(a(20, 0), csc(20, 0));
+  ASSERT_DOUBLE_EQ(0.0, csr(0, 1));
+  ASSERT_THROW(csr.At(n, 0), std::out_of_range);
+
+  // SpMV и SpMM в обоих форматах, в том числе многопоточные
+  S21ThreadPool& pool = S21ThreadPool::Instance();
+  const int initial_threads = pool.GetNumThreads();
+  pool.SetNumThreads(4);
+  const S21Matrix expected = a * b;
+  std::vector<double> x(n);
+  for (int i = 0; i < n; ++i) {
+    x[i] = b(i, 0);
+  }
+  for (const S21SparseMatrix* sparse : {&csr, &csc}) {
+    const S21Matrix product = *sparse * b;
+    const std::vector<double> y = *sparse * x;
+    for (int i = 0; i < n; ++i) {
+      ASSERT_NEAR(expected(i, 0), y[i], 1e-12);
+      for (int j = 0; j < k; ++j) {
+        ASSERT_NEAR(expected(i, j), product(i, j), 1e-12);
+      }
+    }
+  }
+  pool.SetNumThreads(initial_threads);
+  const S21Matrix auto_product = S21SparseMatrix::MulAuto(a, b);
+  ASSERT_NEAR(expected(7, 5), auto_product(7, 5), 1e-12);
+
+  const S21Matrix bt = b.Transpose();
+  const S21Matrix left = bt * csc;
+  const S21Matrix left_expected = bt * a;
+  ASSERT_NEAR(left_expected(3, 4), left(3, 4), 1e-12);
+  ASSERT_EQ(a.Transpose(), csr.Transpose().ToDense());
+  ASSERT_EQ(S21SparseFormat::kCsc, csr.Transpose().GetFormat());
+
+  // сумма со взаимным уничтожением и разными форматами
+  const S21SparseMatrix sum = csr + csc;
+  ASSERT_EQ(a * 2.0, sum.ToDense());
+  const S21SparseMatrix zero = csr + S21SparseMatrix(a * -1.0,
+                                                     S21SparseFormat::kCsc);
+  ASSERT_EQ(0, zero.GetNonZeros());
+  ASSERT_THROW(csr + S21SparseMatrix(n, n + 1), std::invalid_argument);
+  ASSERT_THROW(csr * S21Matrix(n + 1, 2), std::invalid_argument);
+  ASSERT_THROW(csr * std::vector<double>(n + 1), std::invalid_argument);
+
+  // тройки в любом порядке, повторы суммируются, нули не хранятся
+  const S21SparseMatrixI t = S21SparseMatrixI::FromTriplets(
+      3, 4, {{2, 1, 5}, {0, 3, 1}, {2, 1, -5}, {0, 0, 2}, {0, 3, 4}},
+      S21SparseFormat::kCsc);
+  ASSERT_EQ(2, t.GetNonZeros());
+  ASSERT_EQ(5, t(0, 3));
+  ASSERT_EQ(0, t(2, 1));
+  ASSERT_THROW(S21SparseMatrixI::FromTriplets(2, 2, {{2, 0, 1}}),
+               std::out_of_range);
+  S21MatrixI dense_i(4, 2);
+  dense_i(3, 0) = 1 << 30;
+  dense_i(3, 1) = 3;
+  // произведение копится в long long, как в GEMM
+  const S21MatrixI product_i = t * dense_i;
+  ASSERT_EQ(S21MatrixI(t.ToDense() * dense_i), product_i);
+  ASSERT_EQ(15, product_i(0, 1));
+}
+
+/**
+ * @brief Проверяет двоичный формат: сохранение и загрузку копированием и
+ * отображением файла, защиту от чужих и повреждённых файлов.
+ */
+TEST(S21MatrixTest, SaveLoadTest) {
+  const std::string path = testing::TempDir() + "s21_matrix_io_test.bin";
+  S21Matrix a(37, 53);
+  for (int i = 0; i < a.GetRows(); ++i) {
+    for (int j = 0; j < a.GetCols(); ++j) {
+      a(i, j) = std::cos(i * 53.0 + j);
+    }
+  }
+  a.Save(path);
+
+  for (S21MatrixLoadMode mode :
+       {S21MatrixLoadMode::kCopy, S21MatrixLoadMode::kCopyOnWrite}) {
+    const S21Matrix loaded = S21Matrix::Load(path, mode, true);
+    ASSERT_EQ(a, loaded);
+    ASSERT_EQ(a.GetStride(), loaded.GetStride());
+    ASSERT_EQ(0u, reinterpret_cast<std::uintptr_t>(loaded.data()) % 64);
+  }
+
+  // отображение не выделяет буфер, а изменения не попадают в файл
+  S21Matrix mapped;
+  ASSERT_EQ(0, CountAllocations([&] { mapped = S21Matrix::Load(path); }));
+  mapped(5, 7) = 100.0;
+  mapped.MulNumber(2.0);
+  ASSERT_DOUBLE_EQ(200.0, mapped(5, 7));
+  S21Matrix moved(std::move(mapped));
+  ASSERT_EQ(a, S21Matrix::Load(path));
+
+  // отображение только для чтения: представление владеет им, а запись
+  // возможна только в копию или после переназначения
+  S21MatrixView view = S21Matrix::LoadView(path, true);
+  ASSERT_EQ(a, view);
+  const S21MatrixView block =
+      S21Matrix::LoadView(path).Block(1, 2, 3, 4).Transposed();
+  ASSERT_EQ(a.Block(1, 2, 3, 4).Transposed(), block);
+  S21Matrix copy(view);
+  copy = a;
+  copy(0, 0) = -1.0;
+  copy.MulNumber(2.0);
+  ASSERT_DOUBLE_EQ(-2.0, copy(0, 0));
+  view = copy;
+  ASSERT_EQ(copy, view);
+  S21Matrix reloaded = S21Matrix::Load(path);
+  reloaded = copy;  // копирование в отображённый буфер того же размера
+  ASSERT_EQ(copy, reloaded);
+  ASSERT_EQ(a, S21Matrix::LoadView(path));
+
+  // малая матрица во встроенном буфере и целые элементы
+  S21MatrixI small(3, 3);
+  small(2, 1) = -7;
+  small.Save(path);
+  ASSERT_EQ(small, S21MatrixI::Load(path));
+  ASSERT_THROW(S21Matrix::Load(path), std::runtime_error);
+  ASSERT_THROW(S21Matrix::Load(path + ".missing"), std::runtime_error);
+
+  // повреждённые заголовок и данные
+  a.Save(path);
+  std::fstream file(path, std::ios::in | std::ios::out | std::ios::binary);
+  file.seekp(64 + 8 * 100);
+  file.put(0x55);
+  file.flush();
+  ASSERT_NO_THROW(S21Matrix::Load(path));
+  ASSERT_THROW(S21Matrix::Load(path, S21MatrixLoadMode::kCopyOnWrite, true),
+               std::runtime_error);
+  ASSERT_THROW(S21Matrix::Load(path, S21MatrixLoadMode::kCopy, true),
+               std::runtime_error);
+  file.seekp(20);
+  file.put(0x7f);
+  file.close();
+  ASSERT_THROW(S21Matrix::Load(path), std::runtime_error);
+
+  // rows * stride * 8 переполняет uint64_t и даёт 64 байта данных
+  s21::file::Header header = s21::file::MakeHeader(
+      s21::file::ElementType<double>(), sizeof(double), 1073807362, 1,
+      2147352580);
+  ASSERT_EQ(64u, header.payload_bytes);
+  header.header_checksum = s21::file::HeaderChecksum(header);
+  std::ofstream wrapped(path, std::ios::binary | std::ios::trunc);
+  wrapped.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  wrapped.write(std::string(64, '\0').data(), 64);
+  wrapped.close();
+  ASSERT_THROW(S21Matrix::Load(path), std::runtime_error);
+  ASSERT_THROW(S21Matrix::LoadView(path), std::runtime_error);
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief Проверяет умножение файлов по тайлам с малым бюджетом памяти:
+ * неполные крайние тайлы, несколько панелей, запись поверх операнда.
+ */
+TEST(S21MatrixTest, MulFilesTest) {
+  const std::string a_path = testing::TempDir() + "s21_matrix_ooc_a.bin";
+  const std::string b_path = testing::TempDir() + "s21_matrix_ooc_b.bin";
+  const std::string c_path = testing::TempDir() + "s21_matrix_ooc_c.bin";
+  S21Matrix a(70, 50);
+  S21Matrix b(50, 45);
+  for (int i = 0; i < 70; ++i) {
+    for (int j = 0; j < 50; ++j) {
+      a(i, j) = std::sin(i * 50.0 + j);
+    }
+  }
+  for (int i = 0; i < 50; ++i) {
+    for (int j = 0; j < 45; ++j) {
+      b(i, j) = std::cos(i * 45.0 + j);
+    }
+  }
+  a.Save(a_path);
+  b.Save(b_path);
+
+  // 2000 элементов: тайлы 20 x 20, 4 x 3 тайла C по 3 панели
+  S21Matrix::MulFiles(a_path, b_path, c_path, 2000 * sizeof(double));
+  const S21Matrix c =
+      S21Matrix::Load(c_path, S21MatrixLoadMode::kCopyOnWrite, true);
+  const S21Matrix expected = a * b;
+  ASSERT_EQ(70, c.GetRows());
+  ASSERT_EQ(45, c.GetCols());
+  for (int i = 0; i < 70; ++i) {
+    for (int j = 0; j < 45; ++j) {
+      ASSERT_NEAR(expected(i, j), c(i, j), 1e-9);
+    }
+  }
+
+  // 8000 элементов: тайлам 40 x 40 нужна упаковка ядра, поэтому тайлы
+  // уменьшаются до 31 x 31 с панелями 30, которые умножаются без неё
+  S21Matrix::MulFiles(a_path, b_path, c_path, 8000 * sizeof(double));
+  ASSERT_EQ(expected,
+            S21Matrix::Load(c_path, S21MatrixLoadMode::kCopyOnWrite, true));
+
+  // целые: точный результат; короткое внутреннее измерение, тайлы A
+  // переиспользуются; результат заменяет левый операнд
+  S21MatrixI ai(9, 3);
+  S21MatrixI bi(3, 11);
+  for (int i = 0; i < 9; ++i) {
+    for (int j = 0; j < 3; ++j) {
+      ai(i, j) = i - 2 * j;
+    }
+  }
+  for (int i = 0; i < 3; ++i) {
+    for (int j = 0; j < 11; ++j) {
+      bi(i, j) = 3 * i + j - 5;
+    }
+  }
+  ai.Save(a_path);
+  bi.Save(b_path);
+  ASSERT_THROW(S21MatrixI::MulFiles(a_path, b_path, c_path, 4),
+               std::invalid_argument);
+  ASSERT_THROW(S21Matrix::MulFiles(a_path, b_path, c_path),
+               std::runtime_error);
+  S21MatrixI::MulFiles(a_path, b_path, a_path, 40 * sizeof(int));
+  ASSERT_EQ(S21MatrixI(ai * bi),
+            S21MatrixI::Load(a_path, S21MatrixLoadMode::kCopy, true));
+
+  ASSERT_THROW(S21MatrixI::MulFiles(a_path, b_path, c_path),
+               std::invalid_argument);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+/**
+ * @brief Проверяет счётчики операций: при сборке с STATS=1 - вызовы, FLOP,
+ * байты, выделения и гистограмму, без него - что учёт не ведётся.
+ */
+TEST(S21MatrixTest, StatsTest) {
+  S21MatrixStats::Reset();
+  S21Matrix a(20, 30);
+  S21Matrix b(30, 10);
+  const S21Matrix c = a * b;
+  const S21Matrix copy(a);
+  S21Matrix square(5, 5);
+  for (int i = 0; i < 5; ++i) {
+    square(i, i) = 2.0;
+  }
+  ASSERT_DOUBLE_EQ(32.0, square.Determinant());
+  const S21Matrix inverse = square.InverseMatrix();
+  const S21Matrix minor = square.GetMatrixMinor(0, 0);
+
+  const S21MatrixStatsSnapshot snapshot = S21MatrixStats::Snapshot();
+  const std::string json = snapshot.ToJson();
+  if (!S21MatrixStats::kEnabled) {
+    for (const S21MatrixOpStats& op : snapshot.ops) {
+      ASSERT_EQ(0u, op.calls);
+    }
+    ASSERT_NE(std::string::npos, json.find("\"enabled\": false"));
+    return;
+  }
+
+  const S21MatrixOpStats& mul = snapshot[S21MatrixOp::kMulMatrix];
+  ASSERT_EQ(1u, mul.calls);
+  ASSERT_EQ(2ull * 20 * 30 * 10, mul.flops);
+  ASSERT_EQ(sizeof(double) * (20 * 30 + 30 * 10 + 20 * 10), mul.bytes);
+  ASSERT_EQ(1u, mul.allocations);
+  unsigned long long histogram_calls = 0;
+  for (unsigned long long bucket : mul.latency) {
+    histogram_calls += bucket;
+  }
+  ASSERT_EQ(mul.calls, histogram_calls);
+
+  // LU-разложение для Determinant и InverseMatrix работает на копии,
+  // учтённой и в самой операции
+  const S21MatrixOpStats& copies = snapshot[S21MatrixOp::kCopyConstructor];
+  ASSERT_EQ(3u, copies.calls);
+  ASSERT_EQ(3u, copies.allocations);
+  ASSERT_EQ(1u, snapshot[S21MatrixOp::kInverseMatrix].calls);
+  ASSERT_LE(1u, snapshot[S21MatrixOp::kInverseMatrix].allocations);
+  ASSERT_EQ(1u, snapshot[S21MatrixOp::kDeterminant].calls);
+  ASSERT_EQ(2ull * 125 / 3, snapshot[S21MatrixOp::kDeterminant].flops);
+  ASSERT_EQ(2 * sizeof(double) * 16,
+            snapshot[S21MatrixOp::kGetMatrixMinor].bytes);
+  // малый минор 4x4 лежит во встроенном буфере
+  ASSERT_EQ(S21_MATRIX_INLINE_CAPACITY >= 16 ? 0u : 1u,
+            snapshot[S21MatrixOp::kGetMatrixMinor].allocations);
+  ASSERT_NE(std::string::npos, json.find("\"MulMatrix\": {\"calls\": 1, "));
+
+  S21MatrixStats::Reset();
+  ASSERT_EQ(0u, S21MatrixStats::Snapshot()[S21MatrixOp::kMulMatrix].calls);
+}
+
+/**
+ * @brief Проверяет пакет матриц: операции над неполным последним блоком
+ * совпадают с операциями над отдельными матрицами.
+ */
+TEST(S21MatrixTest, BatchTest) {
+  const int count = 37;  // не кратно kLanes
+  std::vector<S21Matrix> a(count, S21Matrix(5, 5));
+  std::vector<S21Matrix> b(count, S21Matrix(5, 5));
+  for (int k = 0; k < count; ++k) {
+    for (int i = 0; i < 5; ++i) {
+      for (int j = 0; j < 5; ++j) {
+        a[k](i, j) = std::sin(k * 25 + i * 5 + j) + (i == j ? 1 + k % 3 : 0);
+        b[k](i, j) = std::cos(k + i * j);
+      }
+    }
+  }
+  const S21MatrixBatch batch_a(a);
+  const S21MatrixBatch batch_b(b);
+  ASSERT_EQ(count, batch_a.GetCount());
+  S21MatrixBatch product = batch_a;
+  product.MulMatrix(batch_b);
+  S21MatrixBatch sum = batch_a;
+  sum.SumMatrix(batch_b);
+  const S21MatrixBatch transposed = batch_a.Transpose();
+  const S21MatrixBatch inverse = batch_a.InverseMatrix();
+  const std::vector<double> det = batch_a.Determinant();
+  ASSERT_EQ(static_cast<std::size_t>(count), det.size());
+  for (int k = 0; k < count; ++k) {
+    ASSERT_TRUE(product.Get(k) == a[k] * b[k]);
+    ASSERT_TRUE(sum.Get(k) == S21Matrix(a[k] + b[k]));
+    ASSERT_TRUE(transposed.Get(k) == a[k].Transpose());
+    // другой порядок операций: совпадение с точностью до округления
+    const S21Matrix expected = a[k].InverseMatrix();
+    for (int i = 0; i < 5; ++i) {
+      for (int j = 0; j < 5; ++j) {
+        ASSERT_NEAR(expected(i, j), inverse(k, i, j), 1e-12);
+      }
+    }
+    ASSERT_NEAR(a[k].Determinant(), det[k], 1e-9);
+  }
+
+  // ведущие строки различаются между матрицами одного блока
+  std::vector<S21Matrix> shifted(10, S21Matrix(4, 4));
+  for (int k = 0; k < 10; ++k) {
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        shifted[k](i, j) = j == (i + k) % 4 ? 4 + i : 0.1 * (i + j);
+      }
+    }
+  }
+  const S21MatrixBatch shifted_batch(shifted);
+  const S21MatrixBatch shifted_inverse = shifted_batch.InverseMatrix();
+  const std::vector<double> shifted_det = shifted_batch.Determinant();
+  for (int k = 0; k < 10; ++k) {
+    const S21Matrix expected = shifted[k].InverseMatrix();
+    for (int i = 0; i < 4; ++i) {
+      for (int j = 0; j < 4; ++j) {
+        ASSERT_NEAR(expected(i, j), shifted_inverse(k, i, j), 1e-12);
+      }
+    }
+    ASSERT_NEAR(shifted[k].Determinant(), shifted_det[k], 1e-9);
+  }
+
+  // целые произведения точные, определители считаются в double
+  S21MatrixBatchI ints(20, 2, 2);
+  for (int k = 0; k < 20; ++k) {
+    ints(k, 0, 0) = k;
+    ints(k, 0, 1) = 1;
+    ints(k, 1, 0) = 2;
+    ints(k, 1, 1) = 3;
+  }
+  S21MatrixBatchI squared = ints;
+  squared.MulMatrix(ints);
+  ASSERT_EQ(19 * 19 + 2, squared(19, 0, 0));
+  ASSERT_EQ(11, squared(0, 1, 1));
+  ASSERT_DOUBLE_EQ(3.0 * 7 - 2, ints.Determinant()[7]);
+  ASSERT_THROW(ints.InverseMatrix(), std::logic_error);
+
+  std::vector<S21Matrix> singular(a.begin(), a.begin() + 10);
+  singular[6] = S21Matrix(5, 5);
+  ASSERT_THROW(S21MatrixBatch(singular).InverseMatrix(), std::logic_error);
+  ASSERT_THROW(product.SumMatrix(S21MatrixBatch(count, 5, 4)),
+               std::invalid_argument);
+  ASSERT_THROW(product.MulMatrix(S21MatrixBatch(count, 4, 5)),
+               std::invalid_argument);
+  ASSERT_THROW(S21MatrixBatch(count, 5, 4).Determinant(), std::logic_error);
+  ASSERT_THROW(product.Get(count), std::out_of_range);
+  ASSERT_THROW(product.Set(0, S21Matrix(4, 5)), std::invalid_argument);
+  ASSERT_THROW(S21MatrixBatch(-1, 2, 2), std::invalid_argument);
+}
+
+/**
+ * @brief Проверяет умножение Штрассена-Винограда: нечётные и
+ * прямоугольные размеры с дополнением нулями, порог и выбор алгоритма.
+ */
+TEST(S21MatrixTest, StrassenTest) {
+  const int crossover = S21Matrix::GetStrassenCrossover();
+  ASSERT_THROW(S21Matrix::SetStrassenCrossover(0), std::invalid_argument);
+  S21Matrix::SetStrassenCrossover(8);  // 4 уровня рекурсии для 67
+  // {m, k, n}; у 32 x 130 * 130 x 8 дополняется только k
+  const int sizes[][3] = {
+      {67, 67, 67}, {37, 50, 23}, {64, 64, 64}, {32, 130, 8}};
+  for (const auto& size : sizes) {
+    S21Matrix a(size[0], size[1]);
+    S21Matrix b(size[1], size[2]);
+    for (int i = 0; i < a.GetRows(); ++i) {
+      for (int j = 0; j < a.GetCols(); ++j) {
+        a(i, j) = std::sin(i * 7 + j);
+      }
+    }
+    for (int i = 0; i < b.GetRows(); ++i) {
+      for (int j = 0; j < b.GetCols(); ++j) {
+        b(i, j) = std::cos(i - j * 3);
+      }
+    }
+    S21Matrix blocked = a;
+    blocked.MulMatrix(b, S21MatrixMulAlgorithm::kBlocked);
+    S21Matrix strassen = a;
+    strassen.MulMatrix(b, S21MatrixMulAlgorithm::kStrassen);
+    // квадратные больше порога kAuto тоже умножает по Штрассену
+    const S21Matrix automatic = a * b;
+    for (int i = 0; i < blocked.GetRows(); ++i) {
+      for (int j = 0; j < blocked.GetCols(); ++j) {
+        ASSERT_NEAR(blocked(i, j), strassen(i, j), 1e-10);
+        ASSERT_NEAR(blocked(i, j), automatic(i, j), 1e-10);
+      }
+    }
+  }
+  S21Matrix::SetStrassenCrossover(crossover);
+
+  // целые всегда умножаются блочным GEMM: результат точный
+  S21MatrixI ints(20, 20);
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 20; ++j) {
+      ints(i, j) = i * 20 + j;
+    }
+  }
+  S21MatrixI::SetStrassenCrossover(4);
+  S21MatrixI strassen = ints;
+  strassen.MulMatrix(ints, S21MatrixMulAlgorithm::kStrassen);
+  S21MatrixI::SetStrassenCrossover(crossover);
+  ASSERT_EQ(strassen, S21MatrixI(ints * ints));
+}
+
+/**
+ * @brief Проверяет решение систем: LU, Холецкий, треугольные и
+ * диагональные матрицы, выбор способа и повторное использование
+ * разложений.
+ */
+TEST(S21MatrixTest, SolveTest) {
+  const int n = 6;
+  S21Matrix general(n, n);
+  S21Matrix spd(n, n);
+  S21Matrix lower(n, n);
+  S21Matrix b(n, 3);
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      general(i, j) = std::sin(i * n + j) + (i == j ? 2.0 : 0.0);
+      spd(i, j) = 1.0 / (1 + std::abs(i - j)) + (i == j ? n : 0.0);
+      lower(i, j) = j <= i ? std::cos(i + j) + 2.0 : 0.0;
+    }
+    for (int j = 0; j < 3; ++j) {
+      b(i, j) = i - j * 0.5;
+    }
+  }
+  S21Matrix diagonal(n, n);
+  for (int i = 0; i < n; ++i) {
+    diagonal(i, i) = i + 1.0;
+  }
+  S21Matrix upper = lower.Transpose();
+  // проверяет A * X = B
+  const auto check = [&](const S21Matrix& a, const S21Matrix& x) {
+    const S21Matrix residual = a * x;
+    for (int i = 0; i < n; ++i) {
+      for (int j = 0; j < 3; ++j) {
+        ASSERT_NEAR(b(i, j), residual(i, j), 1e-12);
+      }
+    }
+  };
+  for (const S21Matrix* a : {&general, &spd, &lower, &upper, &diagonal}) {
+    check(*a, a->Solve(b));
+    check(*a, a->Solve(b, S21MatrixSolver::kLU));
+  }
+  check(spd, spd.Solve(b, S21MatrixSolver::kCholesky));
+  check(lower, lower.Solve(b, S21MatrixSolver::kLowerTriangular));
+  check(upper, upper.Solve(b, S21MatrixSolver::kUpperTriangular));
+  check(diagonal, diagonal.Solve(b, S21MatrixSolver::kDiagonal));
+
+  // разложения переиспользуются для новых правых частей
+  const S21MatrixLU lu = general.LU();
+  const S21MatrixCholesky cholesky = spd.Cholesky();
+  ASSERT_TRUE(cholesky.IsPositiveDefinite());
+  S21Matrix product = cholesky.GetL() * cholesky.GetL().Transpose();
+  for (int i = 0; i < n; ++i) {
+    for (int j = 0; j < n; ++j) {
+      ASSERT_NEAR(spd(i, j), product(i, j), 1e-12);
+    }
+  }
+  check(general, lu.Solve(b));
+  check(spd, cholesky.Solve(b));
+  b.MulNumber(-3.0);
+  check(general, lu.Solve(b));
+  check(spd, cholesky.Solve(b));
+
+  // симметричная, но не положительно определённая: kAuto переходит к LU
+  S21Matrix indefinite(2, 2);
+  indefinite(0, 0) = 1.0;
+  indefinite(0, 1) = 2.0;
+  indefinite(1, 0) = 2.0;
+  indefinite(1, 1) = 1.0;
+  S21Matrix rhs(2, 1);
+  rhs(0, 0) = 3.0;
+  rhs(1, 0) = 3.0;
+  const S21Matrix x = indefinite.Solve(rhs);
+  ASSERT_DOUBLE_EQ(1.0, x(0, 0));
+  ASSERT_DOUBLE_EQ(1.0, x(1, 0));
+  ASSERT_FALSE(indefinite.Cholesky().IsPositiveDefinite());
+  ASSERT_THROW(indefinite.Solve(rhs, S21MatrixSolver::kCholesky),
+               std::logic_error);
+
+  diagonal(2, 2) = 0.0;
+  ASSERT_THROW(diagonal.Solve(b), std::logic_error);
+  ASSERT_THROW(diagonal.Solve(b, S21MatrixSolver::kLU), std::logic_error);
+  ASSERT_THROW(general.Solve(rhs), std::invalid_argument);
+  ASSERT_THROW(S21Matrix(2, 3).Solve(rhs), std::logic_error);
+  ASSERT_THROW(S21MatrixI(2, 2).Solve(S21MatrixI(2, 1)), std::logic_error);
+}
+
+/**
+ * @brief Проверяет Gemm и Gemv: транспонирование множителей, alpha и beta,
+ * векторы-строки и столбцы, совпадение приёмника с множителем.
+ */
+TEST(S21MatrixTest, GemmTest) {
+  const auto fill = [](int rows, int cols, int seed) {
+    S21Matrix result(rows, cols);
+    for (int i = 0; i < rows; ++i) {
+      for (int j = 0; j < cols; ++j) {
+        result(i, j) = std::sin(i * 13 + j * 7 + seed);
+      }
+    }
+    return result;
+  };
+  const auto op = [](const S21Matrix& matrix, S21MatrixTranspose trans) {
+    return trans == S21MatrixTranspose::kNone ? matrix : matrix.Transpose();
+  };
+  const S21MatrixTranspose flags[] = {S21MatrixTranspose::kNone,
+                                      S21MatrixTranspose::kTranspose};
+  // малое произведение и блочное с упаковкой
+  const int sizes[][3] = {{3, 4, 5}, {37, 50, 23}};
+  for (const auto& size : sizes) {
+    const int m = size[0], k = size[1], n = size[2];
+    for (S21MatrixTranspose trans_a : flags) {
+      for (S21MatrixTranspose trans_b : flags) {
+        const S21Matrix a = op(fill(m, k, 1), trans_a);
+        const S21Matrix b = op(fill(k, n, 2), trans_b);
+        const S21Matrix c0 = fill(m, n, 3);
+        S21Matrix c = c0;
+        S21Matrix::Gemm(2.0, a, b, -0.5, c, trans_a, trans_b);
+        const S21Matrix product = op(a, trans_a) * op(b, trans_b);
+        for (int i = 0; i < m; ++i) {
+          for (int j = 0; j < n; ++j) {
+            ASSERT_NEAR(2.0 * product(i, j) - 0.5 * c0(i, j), c(i, j),
+                        1e-12);
+          }
+        }
+      }
+    }
+  }
+
+  // beta = 0 не читает C, а C на месте множителя копируется
+  const S21Matrix square = fill(9, 9, 4);
+  S21Matrix c(9, 9);
+  c(0, 0) = std::numeric_limits<double>::quiet_NaN();
+  S21Matrix::Gemm(1.0, square, square, 0.0, c);
+  ASSERT_EQ(S21Matrix(square * square), c);
+  c = square;
+  S21Matrix::Gemm(1.0, c, c, 1.0, c, S21MatrixTranspose::kTranspose);
+  const S21Matrix expected = square.Transpose() * square + square;
+  for (int i = 0; i < 9; ++i) {
+    for (int j = 0; j < 9; ++j) {
+      ASSERT_NEAR(expected(i, j), c(i, j), 1e-12);
+    }
+  }
+
+  // 45 строк: полосы по 32, 8 и 1 элементу y; 19 столбцов: хвост строки
+  const S21Matrix a = fill(45, 19, 5);
+  const S21Matrix column = fill(19, 1, 6);
+  const S21Matrix row = column.Transpose();
+  for (S21MatrixTranspose trans_a : flags) {
+    const S21Matrix a_op = op(a, trans_a);
+    const S21Matrix product = op(a_op, trans_a) * column;
+    const int m = product.GetRows();
+    for (const S21Matrix* x : {&column, &row}) {
+      S21Matrix y_column = fill(m, 1, 7);
+      S21Matrix y_row = y_column.Transpose();
+      const S21Matrix y0 = y_column;
+      S21Matrix::Gemv(-1.0, a_op, *x, 3.0, y_column, trans_a);
+      S21Matrix::Gemv(-1.0, a_op, *x, 3.0, y_row, trans_a);
+      for (int i = 0; i < m; ++i) {
+        ASSERT_NEAR(3.0 * y0(i, 0) - product(i, 0), y_column(i, 0), 1e-12);
+        ASSERT_NEAR(y_column(i, 0), y_row(0, i), 1e-12);
+      }
+    }
+  }
+
+  // целые копятся в long long и совпадают с operator* точно
+  S21MatrixI ints(20, 30);
+  for (int i = 0; i < 20; ++i) {
+    for (int j = 0; j < 30; ++j) {
+      ints(i, j) = (i * 30 + j) % 17 - 8;
+    }
+  }
+  S21MatrixI gram(30, 30);
+  S21MatrixI::Gemm(3, ints, ints, 0, gram, S21MatrixTranspose::kTranspose);
+  S21MatrixI gram_expected = ints.Transpose() * ints;
+  gram_expected.MulNumber(3);
+  ASSERT_EQ(gram_expected, gram);
+
+  ASSERT_THROW(S21Matrix::Gemm(1.0, a, a, 0.0, c), std::invalid_argument);
+  ASSERT_THROW(S21Matrix::Gemm(1.0, a, a, 0.0, c, S21MatrixTranspose::kNone,
+                               S21MatrixTranspose::kTranspose),
+               std::invalid_argument);
+  S21Matrix y(45, 2);
+  ASSERT_THROW(S21Matrix::Gemv(1.0, a, column, 0.0, y),
+               std::invalid_argument);
+  ASSERT_THROW(S21Matrix::Gemv(1.0, a, fill(45, 1, 8), 0.0, y),
+               std::invalid_argument);
+}
+
 /**
  * @brief Точка входа для запуска тестов.
  * @param argc Количество аргументов командной строки.
@@ -593,6 +2200,8 @@ TEST(S21MatrixTest, InverseMatrixSingularMatrixExceptionTest) {
  * @return Код возврата (0 в случае успешного завершения).
  */
 int main(int argc, char **argv) {
+  std::cout << "SIMD ISA: " << s21::simd::IsaName(s21::simd::ActiveIsa())
+            << std::endl;
   testing::InitGoogleTest(&argc, argv);
   return RUN_ALL_TESTS();
 }